@@ -0,0 +1,63 @@
+#include "Mapped_File.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_MMAP
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+#ifdef MAPPED_FILE_MMAP
+
+Mapped_File::Mapped_File(const std::string &path)
+    : data{nullptr}, size{0}, mapped{false}, opened{false} {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat info;
+    if (::fstat(fd, &info) == 0) {
+        opened = true;
+        size = static_cast<std::size_t>(info.st_size);
+        if (size > 0) {
+            void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                opened = false;
+                size = 0;
+            } else {
+                ::madvise(addr, size, MADV_SEQUENTIAL);       // read ahead, drop pages behind
+                data = static_cast<const char *>(addr);
+                mapped = true;
+            }
+        }
+    }
+    ::close(fd);            // the mapping keeps the file open
+}
+
+Mapped_File::~Mapped_File() {
+    if (mapped)
+        ::munmap(const_cast<char *>(data), size);
+}
+
+#else
+
+Mapped_File::Mapped_File(const std::string &path)
+    : data{nullptr}, size{0}, mapped{false}, opened{false} {
+    std::ifstream in_file {path, std::ios::binary};
+    if (!in_file)
+        return;
+    std::ostringstream buffer;
+    buffer << in_file.rdbuf();
+    contents = buffer.str();
+    data = contents.data();
+    size = contents.size();
+    opened = true;
+}
+
+Mapped_File::~Mapped_File() {
+}
+
+#endif
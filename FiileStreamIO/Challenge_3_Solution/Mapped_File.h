@@ -0,0 +1,29 @@
+#ifndef _MAPPED_FILE_H_
+#define _MAPPED_FILE_H_
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// A whole file mapped read-only into memory
+//
+// The pages are read in by the OS as they are touched, so a multi-gigabyte file can be
+// scanned as one contiguous char range without copying it into a buffer first. On systems
+// without mmap the file is read into memory instead.
+class Mapped_File {
+private:
+    const char *data;
+    std::size_t size;
+    std::string contents;           // only used where the file can't be mapped
+    bool mapped;
+    bool opened;
+public:
+    explicit Mapped_File(const std::string &path);
+    ~Mapped_File();
+    Mapped_File(const Mapped_File &) = delete;
+    Mapped_File &operator=(const Mapped_File &) = delete;
+    
+    explicit operator bool() const { return opened; }      // false if the file couldn't be opened
+    std::string_view view() const { return std::string_view{data, size}; }
+};
+
+#endif // _MAPPED_FILE_H_
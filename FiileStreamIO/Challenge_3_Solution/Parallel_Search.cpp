@@ -0,0 +1,91 @@
+#include <thread>
+#include "Parallel_Search.h"
+
+std::vector<std::string_view> split_at_words(std::string_view text, std::size_t parts) {
+    if (parts == 0)
+        parts = 1;
+    std::vector<std::string_view> ranges;
+    std::size_t begin {0};
+    for (std::size_t i = 1; i <= parts; ++i) {
+        std::size_t end = (i == parts) ? text.size() : text.size() / parts * i;
+        if (end < begin)
+            end = begin;
+        while (end < text.size() && !is_word_space(text[end]))
+            ++end;
+        ranges.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return ranges;
+}
+
+// Runs search(range, index) for every range, the first one on the calling thread
+template <typename Search>
+static void run_ranges(const std::vector<std::string_view> &ranges, Search search) {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+        threads.emplace_back(search, ranges[i], i);
+    search(ranges[0], 0);
+    for (auto &t: threads)
+        t.join();
+}
+
+Search_Result parallel_search_words(std::string_view text, std::string_view needle, std::size_t threads,
+                                    std::vector<std::string_view> *matched) {
+    std::vector<std::string_view> ranges = split_at_words(text, threads);
+    std::vector<Search_Result> results(ranges.size());
+    std::vector<std::vector<std::string_view>> found(ranges.size());
+    
+    run_ranges(ranges, [&](std::string_view range, std::size_t i) {
+        if (matched)
+            results[i] = search_words(range, needle, [&](std::string_view word) { found[i].push_back(word); });
+        else
+            results[i] = search_words(range, needle, [](std::string_view) {});
+    });
+    
+    Search_Result total;
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+        total.words += results[i].words;
+        total.matches += results[i].matches;
+        if (matched)
+            matched->insert(matched->end(), found[i].begin(), found[i].end());
+    }
+    return total;
+}
+
+Term_Result parallel_search_terms(const Term_Automaton &automaton, std::string_view text, std::size_t threads,
+                                  std::vector<std::pair<std::size_t, std::string_view>> *matched) {
+    std::vector<std::string_view> ranges = split_at_words(text, threads);
+    std::vector<Term_Result> results(ranges.size());
+    std::vector<std::vector<std::pair<std::size_t, std::string_view>>> found(ranges.size());
+    
+    run_ranges(ranges, [&](std::string_view range, std::size_t i) {
+        if (matched)
+            results[i] = automaton.search(range, [&](std::size_t t, std::string_view word) { found[i].emplace_back(t, word); });
+        else
+            results[i] = automaton.search(range);
+    });
+    
+    Term_Result total;
+    total.matches.assign(automaton.size(), 0);
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+        total.words += results[i].words;
+        for (std::size_t t = 0; t < automaton.size(); ++t)
+            total.matches[t] += results[i].matches[t];
+        if (matched)
+            matched->insert(matched->end(), found[i].begin(), found[i].end());
+    }
+    return total;
+}
+
+Word_Counts parallel_count_words(std::string_view text, std::size_t threads) {
+    std::vector<std::string_view> ranges = split_at_words(text, threads);
+    std::vector<Word_Counts> counts(ranges.size());
+    
+    run_ranges(ranges, [&](std::string_view range, std::size_t i) {
+        counts[i].add(range);
+    });
+    
+    for (std::size_t i = 1; i < counts.size(); ++i)
+        counts[0].merge(counts[i]);
+    return std::move(counts[0]);
+}
@@ -0,0 +1,34 @@
+#ifndef _PARALLEL_SEARCH_H_
+#define _PARALLEL_SEARCH_H_
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Word_Search.h"
+#include "Term_Search.h"
+#include "Word_Frequency.h"
+
+// Parallel word search
+//
+// Splits the text into one byte range per thread, moving each split point forward to the
+// next whitespace so no word is cut in two, searches the ranges at the same time and adds
+// up the counts. The results are the same as searching the whole text on one thread.
+// Matches found by the threads are collected per range and handed back in text order.
+
+// Splits text into parts ranges of about the same size, each starting at whitespace or at
+// the start of the text
+std::vector<std::string_view> split_at_words(std::string_view text, std::size_t parts);
+
+// search_words on threads threads - the words containing needle are added to matched, if given
+Search_Result parallel_search_words(std::string_view text, std::string_view needle, std::size_t threads,
+                                    std::vector<std::string_view> *matched = nullptr);
+
+// Term_Automaton::search on threads threads - each (term, word) found is added to matched, if given
+Term_Result parallel_search_terms(const Term_Automaton &automaton, std::string_view text, std::size_t threads,
+                                  std::vector<std::pair<std::size_t, std::string_view>> *matched = nullptr);
+
+// Word frequencies on threads threads - each thread counts its range into its own Word_Counts,
+// and those are merged into the first one at the end
+Word_Counts parallel_count_words(std::string_view text, std::size_t threads);
+
+#endif // _PARALLEL_SEARCH_H_
@@ -0,0 +1,124 @@
+#include <deque>
+#include "Term_Search.h"
+
+Term_Automaton::Term_Automaton(std::vector<std::string> terms)
+    : terms{std::move(terms)}, byte_class{}, class_count{2}, class_shift{1}, output_from{0} {
+    // Byte classes: 0 for whitespace, 1 for bytes in no term, then one per byte the terms use
+    const std::uint8_t other_class = 1;
+    for (int b = 0; b < 256; ++b)
+        byte_class[b] = is_word_space(static_cast<char>(b)) ? space_class : other_class;
+    std::vector<bool> searchable(this->terms.size());
+    for (std::size_t t = 0; t < this->terms.size(); ++t) {
+        const std::string &term = this->terms[t];
+        bool ok = !term.empty();
+        for (char ch: term)
+            ok = ok && !is_word_space(ch);
+        searchable[t] = ok;
+        if (!ok)
+            continue;
+        for (char ch: term) {
+            unsigned char b = static_cast<unsigned char>(ch);
+            if (byte_class[b] == other_class)
+                byte_class[b] = static_cast<std::uint8_t>(class_count++);
+        }
+    }
+    
+    // Trie of the terms
+    std::vector<std::int32_t> next(class_count, none);      // next[state * class_count + class]
+    state_pattern.assign(1, none);
+    same_term.assign(this->terms.size(), none);
+    term_pattern.assign(this->terms.size(), none);
+    std::vector<std::int32_t> last_term;        // per pattern, where to add the next repeat
+    for (std::size_t t = 0; t < this->terms.size(); ++t) {
+        if (!searchable[t])
+            continue;
+        std::int32_t state {0};
+        for (char ch: this->terms[t]) {
+            std::size_t slot = static_cast<std::size_t>(state) * class_count + byte_class[static_cast<unsigned char>(ch)];
+            if (next[slot] == none) {
+                next[slot] = static_cast<std::int32_t>(state_pattern.size());
+                state_pattern.push_back(none);
+                next.resize(next.size() + class_count, none);
+            }
+            state = next[slot];
+        }
+        // repeats of a term join its pattern, in list order
+        std::int32_t p = state_pattern[state];
+        if (p == none) {
+            p = state_pattern[state] = static_cast<std::int32_t>(first_term.size());
+            first_term.push_back(static_cast<std::int32_t>(t));
+            last_term.push_back(static_cast<std::int32_t>(t));
+        } else {
+            same_term[last_term[p]] = static_cast<std::int32_t>(t);
+            last_term[p] = static_cast<std::int32_t>(t);
+        }
+        term_pattern[t] = p;
+    }
+    
+    // Failure links, breadth first, filling in the missing transitions as we go so every
+    // state ends up with a next state for every class
+    std::size_t states = state_pattern.size();
+    std::vector<std::int32_t> fail(states, 0);
+    std::vector<std::int32_t> output(states, none);     // itself if a term ends there, else suffix
+    std::vector<std::int32_t> suffix(states, none);      // the longest proper suffix state where a term ends
+    output[0] = none;             // the empty term isn't searched for
+    std::deque<std::int32_t> queue;
+    for (std::size_t c = 0; c < class_count; ++c) {
+        std::int32_t child = next[c];
+        if (child == none) {
+            next[c] = 0;
+        } else {
+            fail[child] = 0;
+            suffix[child] = none;
+            output[child] = (state_pattern[child] != none) ? child : none;
+            queue.push_back(child);
+        }
+    }
+    while (!queue.empty()) {
+        std::int32_t state = queue.front();
+        queue.pop_front();
+        std::size_t row = static_cast<std::size_t>(state) * class_count;
+        std::size_t fail_row = static_cast<std::size_t>(fail[state]) * class_count;
+        for (std::size_t c = 0; c < class_count; ++c) {
+            std::int32_t child = next[row + c];
+            if (child == none) {
+                next[row + c] = next[fail_row + c];
+            } else {
+                fail[child] = next[fail_row + c];
+                suffix[child] = output[fail[child]];
+                output[child] = (state_pattern[child] != none) ? child : suffix[child];
+                queue.push_back(child);
+            }
+        }
+    }
+    
+    // Renumber the states so the ones where a term ends come last, then lay the table out
+    // with power-of-two rows holding row offsets
+    std::vector<std::int32_t> renumber(states);
+    std::int32_t count {0};
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1)
+            output_from = static_cast<std::uint32_t>(count);
+        for (std::size_t s = 0; s < states; ++s)
+            if ((output[s] != none) == (pass == 1))
+                renumber[s] = count++;
+    }
+    while ((std::size_t{1} << class_shift) < class_count)
+        ++class_shift;
+    output_from <<= class_shift;
+    table.assign(states << class_shift, 0);
+    std::vector<std::int32_t> old_pattern {std::move(state_pattern)};
+    state_pattern.assign(states, none);
+    suffix_output.assign(states, none);
+    for (std::size_t s = 0; s < states; ++s) {
+        std::size_t row = static_cast<std::size_t>(renumber[s]) << class_shift;
+        for (std::size_t c = 0; c < class_count; ++c)
+            table[row + c] = static_cast<std::uint32_t>(renumber[next[s * class_count + c]]) << class_shift;
+        state_pattern[renumber[s]] = old_pattern[s];
+        suffix_output[renumber[s]] = (suffix[s] == none) ? none : renumber[suffix[s]];
+    }
+}
+
+Term_Result Term_Automaton::search(std::string_view text) const {
+    return search(text, [](std::size_t, std::string_view) {});
+}
@@ -0,0 +1,120 @@
+#ifndef _TERM_SEARCH_H_
+#define _TERM_SEARCH_H_
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Word_Search.h"
+
+// Counts for a multi-term search
+struct Term_Result {
+    std::size_t words {0};                      // words searched
+    std::vector<std::size_t> matches;           // per term, words containing it
+};
+
+// Multi-term word search (Aho-Corasick)
+//
+// Built once from a list of terms, then finds all of them in a single pass over the text,
+// however many there are - one table lookup per byte instead of one pass per term. Counts, per
+// term, the words that contain it, the same as running search_words for each term on its own.
+// Terms that contain whitespace can never be part of a word, and the empty term isn't searched
+// for; both are counted as 0.
+//
+// The automaton is a complete DFA: every state has a next state for every byte class, so
+// failure links are only followed while it is built, never while searching. Bytes that appear
+// in no term share one class, so the table stays small for large term lists. The table holds
+// each next state as its row's offset, and the states where a term ends are numbered last, so
+// a step is one load and the check for a match one compare.
+class Term_Automaton {
+private:
+    static constexpr std::int32_t none = -1;
+    static constexpr std::uint8_t space_class = 0;          // whitespace - ends a word
+    
+    std::vector<std::string> terms;
+    std::uint8_t byte_class[256];
+    std::size_t class_count;
+    unsigned class_shift;                       // rows are 1 << class_shift entries, class_count or more
+    std::vector<std::uint32_t> table;           // table[(state << class_shift) + class] - the next state << class_shift
+    std::uint32_t output_from;                  // states from here (<< class_shift) on have a term ending in them
+    std::vector<std::int32_t> state_pattern;     // per state, the pattern ending exactly there
+    // Terms with the same chars share one pattern, so a term list with repeats costs no more
+    std::vector<std::int32_t> first_term;        // per pattern, first term with its chars
+    std::vector<std::int32_t> same_term;         // per term, next term with the same chars
+    std::vector<std::int32_t> term_pattern;      // per term, its pattern - none if it isn't searched for
+    std::vector<std::int32_t> suffix_output;     // per state, the longest proper suffix state where a term ends
+public:
+    explicit Term_Automaton(std::vector<std::string> terms);
+    
+    std::size_t size() const { return terms.size(); }
+    const std::string &term(std::size_t index) const { return terms[index]; }
+    
+    // Counts the words of text, and per term the words containing it
+    Term_Result search(std::string_view text) const;
+    
+    // As above, also calling on_match(term index, word) for every word a term is found in,
+    // once per term and word, in text order
+    template <typename On_Match>
+    Term_Result search(std::string_view text, On_Match on_match) const;
+};
+
+template <typename On_Match>
+Term_Result Term_Automaton::search(std::string_view text, On_Match on_match) const {
+    Term_Result result;
+    result.matches.assign(terms.size(), 0);
+    std::vector<std::size_t> counts(first_term.size(), 0);
+    std::vector<std::size_t> last_word(first_term.size(), std::numeric_limits<std::size_t>::max());
+    std::vector<std::int32_t> found;            // patterns found in the current word
+    
+    const std::uint32_t *next = table.data();
+    std::uint32_t at {0};          // the current state << class_shift
+    std::size_t word_begin {0};      // where the current word starts
+    std::size_t found_word {0};      // where the word the found patterns are in starts
+    bool after_space {true};
+    
+    // Whitespace leads every state back to the start, so the loop needs no branch for it;
+    // words are counted and their starts tracked without branches too. Only a byte that ends
+    // a term leaves the straight path - the word it's in gets its end found then.
+    auto report_found = [&]() {
+        std::size_t word_end = found_word;
+        while (word_end < text.size() && !is_word_space(text[word_end]))
+            ++word_end;
+        for (std::int32_t p: found)
+            for (std::int32_t t = first_term[p]; t != none; t = same_term[t])
+                on_match(static_cast<std::size_t>(t), text.substr(found_word, word_end - found_word));
+        found.clear();
+    };
+    
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        std::uint8_t c = byte_class[static_cast<unsigned char>(text[i])];
+        bool space = (c == space_class);
+        result.words += after_space & !space;
+        after_space = space;
+        word_begin = space ? i + 1 : word_begin;
+        at = next[at + c];
+        if (at < output_from)
+            continue;
+        if (!found.empty() && found_word != word_begin)
+            report_found();
+        found_word = word_begin;
+        std::int32_t s = static_cast<std::int32_t>(at >> class_shift);
+        if (state_pattern[s] == none)
+            s = suffix_output[s];
+        for (; s != none; s = suffix_output[s]) {
+            std::int32_t p = state_pattern[s];
+            if (last_word[p] != word_begin) {
+                last_word[p] = word_begin;
+                ++counts[p];
+                found.push_back(p);
+            }
+        }
+    }
+    if (!found.empty())
+        report_found();
+    for (std::size_t t = 0; t < terms.size(); ++t)
+        result.matches[t] = (term_pattern[t] == none) ? 0 : counts[term_pattern[t]];
+    return result;
+}
+
+#endif // _TERM_SEARCH_H_
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include "Word_Frequency.h"
+#include "Word_Search.h"
+
+// ASCII punctuation, as std::ispunct has it in the C locale
+static bool is_punct(char c) {
+    return (c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~');
+}
+
+static char fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// Per byte: what it folds to, and whether it is whitespace or punctuation - one lookup
+// instead of a handful of compares for every char of every word
+struct Char_Table {
+    static constexpr std::uint8_t space = 1;
+    static constexpr std::uint8_t punct = 2;
+    char folded[256];
+    std::uint8_t kind[256];
+    
+    Char_Table() {
+        for (int b = 0; b < 256; ++b) {
+            char c = static_cast<char>(b);
+            folded[b] = fold(c);
+            kind[b] = is_word_space(c) ? space : is_punct(c) ? punct : 0;
+        }
+    }
+};
+
+static const Char_Table chars_table;
+
+// Hash of the folded chars, 8 at a time - each block is mixed in with a multiply and the
+// result finished like MurmurHash3's fmix64
+static std::uint64_t hash_folded(const char *word, std::size_t length) {
+    std::uint64_t hash {length * 0x9E3779B97F4A7C15ull};
+    std::size_t i {0};
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t block;
+        std::memcpy(&block, word + i, 8);
+        hash = (hash ^ block) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    if (i < length) {
+        std::uint64_t block {0};
+        std::memcpy(&block, word + i, length - i);
+        hash = (hash ^ block) * 0xFF51AFD7ED558CCDull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Trims the punctuation off both ends of a word and folds it into buffer, returning its length
+static std::size_t fold_word(std::string_view word, std::vector<char> &buffer) {
+    std::size_t begin {0};
+    std::size_t end {word.size()};
+    while (begin < end && is_punct(word[begin]))
+        ++begin;
+    while (end > begin && is_punct(word[end - 1]))
+        --end;
+    buffer.resize(end - begin);
+    for (std::size_t i = begin; i < end; ++i)
+        buffer[i - begin] = fold(word[i]);
+    return end - begin;
+}
+
+Word_Counts::Word_Counts()
+    : slots(1024, Slot{0, 0, 0, 0}), distinct_words{0}, total_words{0} {
+}
+
+// One pass per word: skip the whitespace and leading punctuation, then fold the chars into
+// the buffer while remembering where the last one that isn't punctuation went
+void Word_Counts::add(std::string_view text) {
+    const Char_Table &table = chars_table;
+    std::vector<char> folded(64);           // reused for every word, grown for long ones
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(text.data());
+    const unsigned char *end = p + text.size();
+    while (p != end) {
+        while (p != end && table.kind[*p] != 0)
+            ++p;
+        std::size_t length {0};
+        std::size_t kept {0};                // length without the trailing punctuation
+        for (; p != end && table.kind[*p] != Char_Table::space; ++p) {
+            if (length == folded.size())
+                folded.resize(length * 2);
+            folded[length++] = table.folded[*p];
+            kept = (table.kind[*p] == Char_Table::punct) ? kept : length;
+        }
+        if (kept > 0)
+            add_folded(folded.data(), kept, hash_folded(folded.data(), kept), 1);
+    }
+}
+
+// Adds count to a folded word's entry, interning the word if it is new
+void Word_Counts::add_folded(const char *word, std::size_t length, std::uint64_t hash, std::size_t count) {
+    total_words += count;
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+        Slot &slot = slots[i];
+        if (slot.count == 0) {
+            slot = Slot {hash, chars.size(), static_cast<std::uint32_t>(length), count};
+            chars.insert(chars.end(), word, word + length);
+            if (++distinct_words * 2 > slots.size())
+                grow();
+            return;
+        }
+        if (slot.hash == hash && slot.length == length && std::memcmp(chars.data() + slot.offset, word, length) == 0) {
+            slot.count += count;
+            return;
+        }
+    }
+}
+
+// Doubles the table, placing every entry again by its stored hash - the chars don't move
+void Word_Counts::grow() {
+    std::vector<Slot> old(slots.size() * 2, Slot{0, 0, 0, 0});
+    old.swap(slots);
+    std::size_t mask = slots.size() - 1;
+    for (const Slot &slot: old) {
+        if (slot.count == 0)
+            continue;
+        std::size_t i = slot.hash & mask;
+        while (slots[i].count != 0)
+            i = (i + 1) & mask;
+        slots[i] = slot;
+    }
+}
+
+void Word_Counts::merge(const Word_Counts &other) {
+    for (const Slot &slot: other.slots)
+        if (slot.count != 0)
+            add_folded(other.chars.data() + slot.offset, slot.length, slot.hash, slot.count);
+}
+
+std::size_t Word_Counts::count(std::string_view word) const {
+    std::vector<char> folded;
+    std::size_t length = fold_word(word, folded);
+    if (length == 0)
+        return 0;
+    std::uint64_t hash = hash_folded(folded.data(), length);
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash & mask; slots[i].count != 0; i = (i + 1) & mask) {
+        const Slot &slot = slots[i];
+        if (slot.hash == hash && slot.length == length && std::memcmp(chars.data() + slot.offset, folded.data(), length) == 0)
+            return slot.count;
+    }
+    return 0;
+}
+
+// A min-heap of the best k seen so far - O(n log k) rather than sorting every word
+std::vector<Word_Count> Word_Counts::top(std::size_t k) const {
+    // true if a ranks above b
+    auto ranks_above = [](const Word_Count &a, const Word_Count &b) {
+        return a.count > b.count || (a.count == b.count && a.word < b.word);
+    };
+    std::priority_queue<Word_Count, std::vector<Word_Count>, decltype(ranks_above)> best {ranks_above};
+    if (k == 0)
+        return {};
+    for (const Slot &slot: slots) {
+        if (slot.count == 0)
+            continue;
+        Word_Count entry {std::string_view(chars.data() + slot.offset, slot.length), slot.count};
+        if (best.size() < k) {
+            best.push(entry);
+        } else if (ranks_above(entry, best.top())) {
+            best.pop();
+            best.push(entry);
+        }
+    }
+    std::vector<Word_Count> result;
+    result.reserve(best.size());
+    while (!best.empty()) {
+        result.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
@@ -0,0 +1,54 @@
+#ifndef _WORD_FREQUENCY_H_
+#define _WORD_FREQUENCY_H_
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+struct Word_Count {
+    std::string_view word;          // points into the Word_Counts it came from, until it next changes
+    std::size_t count;
+};
+
+// Word frequency counts
+//
+// Counts how often each word occurs, ignoring case: words are the runs of chars between
+// whitespace, as everywhere else in the word counter, with punctuation at either end dropped
+// ("Romeo," and "romeo" are the same word; "love's" keeps its apostrophe) and ASCII letters
+// folded to lowercase. A word that is all punctuation isn't counted.
+//
+// The table is open addressing with linear probing over a flat array of slots, and each
+// distinct word's chars are interned once into a single growing char array the slots point
+// into, so counting allocates only when the table or the char array grows - never per word.
+// Tables counted separately (e.g. one per thread) can be merged into one.
+class Word_Counts {
+private:
+    struct Slot {
+        std::uint64_t hash;
+        std::size_t offset;           // of the word in chars
+        std::uint32_t length;
+        std::size_t count;            // 0 for an empty slot
+    };
+    
+    std::vector<Slot> slots;            // size is a power of two, at most half full
+    std::vector<char> chars;            // every distinct word, back to back
+    std::size_t distinct_words;
+    std::size_t total_words;
+    
+    void add_folded(const char *word, std::size_t length, std::uint64_t hash, std::size_t count);
+    void grow();
+public:
+    Word_Counts();
+    
+    void add(std::string_view text);                // count every word in text
+    void merge(const Word_Counts &other);           // add other's counts to these
+    
+    std::size_t total() const { return total_words; }         // words counted
+    std::size_t distinct() const { return distinct_words; }   // different words among them
+    std::size_t count(std::string_view word) const;           // times word was counted, folded the same way
+    
+    // The k most frequent words, most frequent first - words with the same count alphabetically
+    std::vector<Word_Count> top(std::size_t k) const;
+};
+
+#endif // _WORD_FREQUENCY_H_
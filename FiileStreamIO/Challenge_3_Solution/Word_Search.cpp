@@ -0,0 +1,94 @@
+#include <cstring>
+#include "Word_Search.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const char *find_substring_scalar(const char *first, const char *last, std::string_view needle) {
+    std::string_view haystack(first, last - first);
+    std::size_t found = haystack.find(needle);
+    return (found == std::string_view::npos) ? last : first + found;
+}
+
+static std::size_t count_word_starts_scalar(const char *text_begin, const char *first, const char *last) {
+    std::size_t count {0};
+    bool after_space = (first == text_begin) || is_word_space(first[-1]);
+    for (const char *p = first; p != last; ++p) {
+        bool space = is_word_space(*p);
+        count += after_space && !space;
+        after_space = space;
+    }
+    return count;
+}
+
+#if defined(__SSE2__)
+
+// Bytes of block that are whitespace, as 0xFF
+static inline __m128i space_mask(__m128i block) {
+    __m128i blank = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+    // '\t'..'\r' are 9..13 - signed compares are fine, bytes >= 0x80 compare as negative
+    __m128i above = _mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1));
+    __m128i below = _mm_cmplt_epi8(block, _mm_set1_epi8('\r' + 1));
+    return _mm_or_si128(blank, _mm_and_si128(above, below));
+}
+
+// First/last byte filter: compare 16 candidate positions at once against the needle's first
+// and last chars, and only memcmp the middle of positions where both match. The last char
+// rules out most of the false starts a first-char-only filter (memchr) stops at.
+const char *find_substring(const char *first, const char *last, std::string_view needle) {
+    std::size_t n = needle.size();
+    if (n == 0)
+        return first;
+    if (static_cast<std::size_t>(last - first) < n)
+        return last;
+    if (n == 1) {
+        const void *found = std::memchr(first, needle[0], last - first);
+        return found ? static_cast<const char *>(found) : last;
+    }
+    const __m128i first_char = _mm_set1_epi8(needle[0]);
+    const __m128i last_char = _mm_set1_epi8(needle[n - 1]);
+    const char *p = first;
+    // every candidate in a block must fit, and so must the 16 bytes loaded at its last char
+    for (; p + n - 1 + 16 <= last; p += 16) {
+        __m128i starts = _mm_cmpeq_epi8(first_char, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+        __m128i ends = _mm_cmpeq_epi8(last_char, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + n - 1)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(starts, ends)));
+        while (mask != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (std::memcmp(p + bit + 1, needle.data() + 1, n - 2) == 0)
+                return p + bit;
+            mask &= mask - 1;
+        }
+    }
+    return find_substring_scalar(p, last, needle);
+}
+
+// A word starts wherever a non-space byte follows a space byte - compare each block with
+// the same block shifted back by one byte and count the bits
+std::size_t count_word_starts(const char *text_begin, const char *first, const char *last) {
+    std::size_t count {0};
+    const char *p = first;
+    if (p == text_begin && p != last) {
+        count += !is_word_space(*p);
+        ++p;
+    }
+    for (; p + 16 <= last; p += 16) {
+        __m128i here = space_mask(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+        __m128i before = space_mask(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p - 1)));
+        count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_andnot_si128(here, before))));
+    }
+    return count + count_word_starts_scalar(text_begin, p, last);
+}
+
+#else
+
+const char *find_substring(const char *first, const char *last, std::string_view needle) {
+    return find_substring_scalar(first, last, needle);
+}
+
+std::size_t count_word_starts(const char *text_begin, const char *first, const char *last) {
+    return count_word_starts_scalar(text_begin, first, last);
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef _WORD_SEARCH_H_
+#define _WORD_SEARCH_H_
+#include <cstddef>
+#include <string_view>
+
+// Word search over raw text
+//
+// Counts the words in a block of text and the words that contain a substring, with the same
+// answer as reading word by word with in_file >> word_read and calling find on each one - words
+// are runs of chars between whitespace (space, \t, \n, \v, \f, \r) - but without building a
+// string per word. The text is searched for the substring directly, 16 bytes at a time, and
+// the words between matches are only counted, also 16 bytes at a time.
+
+struct Search_Result {
+    std::size_t words {0};           // words searched
+    std::size_t matches {0};         // words containing the substring
+};
+
+// true for the chars operator>> stops a word at
+inline bool is_word_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Position of the first occurrence of needle in [first, last), or last if there is none
+const char *find_substring(const char *first, const char *last, std::string_view needle);
+
+// Number of words that start in [first, last) - chars that aren't whitespace and follow
+// whitespace, or begin the text. text_begin is where the whole text starts.
+std::size_t count_word_starts(const char *text_begin, const char *first, const char *last);
+
+// Counts the words of text and the ones containing needle, calling on_match(word) for each
+// of those in order
+template <typename On_Match>
+Search_Result search_words(std::string_view text, std::string_view needle, On_Match on_match) {
+    Search_Result result;
+    const char *begin = text.data();
+    const char *end = begin + text.size();
+    
+    bool searchable = !needle.empty();
+    for (char c: needle)
+        searchable = searchable && !is_word_space(c);
+    if (!searchable) {
+        // every word contains an empty substring, and none contains whitespace
+        for (const char *p = begin; p != end; ) {
+            while (p != end && is_word_space(*p))
+                ++p;
+            const char *word = p;
+            while (p != end && !is_word_space(*p))
+                ++p;
+            if (p != word) {
+                ++result.words;
+                if (needle.empty()) {
+                    ++result.matches;
+                    on_match(std::string_view(word, p - word));
+                }
+            }
+        }
+        return result;
+    }
+    
+    const char *pos = begin;        // everything before pos has been counted
+    for (;;) {
+        const char *hit = find_substring(pos, end, needle);
+        if (hit == end) {
+            result.words += count_word_starts(begin, pos, end);
+            return result;
+        }
+        const char *word = hit;
+        while (word != pos && !is_word_space(word[-1]))
+            --word;
+        const char *word_end = hit + needle.size();
+        while (word_end != end && !is_word_space(*word_end))
+            ++word_end;
+        result.words += count_word_starts(begin, pos, word) + 1;
+        ++result.matches;
+        on_match(std::string_view(word, word_end - word));
+        pos = word_end;
+    }
+}
+
+#endif // _WORD_SEARCH_H_
@@ -1,8 +1,33 @@
 // Section 19
 // Challenge 3 - Solution
 // Word counter
+//
+// ./word_counter                   reads ../romeoandjuliet.txt a word at a time, as in the lesson
+// ./word_counter --mmap [file]     maps the file (../romeoandjuliet.txt by default) into memory and
+//                                  searches its raw bytes - see Word_Search.h. Same answers, but
+//                                  no string per word, so it keeps up with gigabyte files.
+// ./word_counter --terms terms.txt [file] [--matches]
+//                                  counts every term in terms.txt (whitespace separated) in one
+//                                  pass over the mapped file - see Term_Search.h. --matches also
+//                                  prints each term and word it was found in as they are found.
+//
+// ./word_counter --top K [file]   counts how often every word occurs, ignoring case and punctuation
+//                                  at either end, and lists the K most frequent - see Word_Frequency.h.
+//
+// The mapped modes take --threads N to search N parts of the file at once - see Parallel_Search.h.
+// Matches are still printed in file order, once all the parts are done.
+//
+// Build with e.g. g++ -std=c++17 -O2 -pthread main.cpp Word_Search.cpp Term_Search.cpp Word_Frequency.cpp Parallel_Search.cpp Mapped_File.cpp -o word_counter
 #include <iostream>
+#include <charconv>
 #include <fstream>
+#include <string>
+#include <vector>
+#include "Mapped_File.h"
+#include "Word_Search.h"
+#include "Term_Search.h"
+#include "Word_Frequency.h"
+#include "Parallel_Search.h"
 
 // return true if the string word_to_find is in the target string
 bool find_substring(const std::string &word_to_find, const std::string &target) {
@@ -13,21 +38,19 @@ bool find_substring(const std::string &word_to_find, const std::string &target)
         return true;
 }
 
-int main() {
+// The lesson's version - one std::string per word read
+int search_stream(const std::string &path, const std::string &word_to_find) {
     std::ifstream in_file {};
-    std::string word_to_find {};
     std::string word_read {};
     int word_count {0};
     int match_count {0};
     
-    in_file.open("../romeoandjuliet.txt");
+    in_file.open(path);
      if (!in_file) {
         std::cerr << "Problem opening file" << std::endl;
         return 1;
     }
    
-    std::cout << "Enter the substring to search for: ";
-    std::cin >> word_to_find;
     while (in_file >> word_read) {
         ++word_count;
         if (find_substring(word_to_find, word_read)) {
@@ -40,6 +63,147 @@ int main() {
     std::cout << "The substring " << word_to_find << " was found " << match_count << " times " << std::endl;
     
     in_file.close();
-    std::cout << std::endl;
     return 0;
 }
+
+// Memory-mapped search over the raw bytes
+int search_mapped(const std::string &path, const std::string &word_to_find, std::size_t threads) {
+    Mapped_File file {path};
+    if (!file) {
+        std::cerr << "Problem opening file" << std::endl;
+        return 1;
+    }
+    
+    auto print = [](std::string_view word) {
+        std::cout.write(word.data(), word.size());
+        std::cout.put(' ');
+    };
+    Search_Result result;
+    if (threads > 1) {
+        std::vector<std::string_view> matched;
+        result = parallel_search_words(file.view(), word_to_find, threads, &matched);
+        for (std::string_view word: matched)
+            print(word);
+    } else {
+        result = search_words(file.view(), word_to_find, print);
+    }
+    
+    std::cout << result.words << " words were searched..." << std::endl;
+    std::cout << "The substring " << word_to_find << " was found " << result.matches << " times " << std::endl;
+    return 0;
+}
+
+// Every term in terms_path in one pass over the mapped file
+int search_terms(const std::string &path, const std::string &terms_path, bool print_matches, std::size_t threads) {
+    std::ifstream terms_file {terms_path};
+    if (!terms_file) {
+        std::cerr << "Problem opening terms file" << std::endl;
+        return 1;
+    }
+    std::vector<std::string> terms;
+    std::string term;
+    while (terms_file >> term)
+        terms.push_back(term);
+    
+    Mapped_File file {path};
+    if (!file) {
+        std::cerr << "Problem opening file" << std::endl;
+        return 1;
+    }
+    
+    Term_Automaton automaton {terms};
+    auto print = [&](std::size_t t, std::string_view word) {
+        std::cout << automaton.term(t) << '\t';
+        std::cout.write(word.data(), word.size());
+        std::cout.put('\n');
+    };
+    Term_Result result;
+    if (threads > 1) {
+        std::vector<std::pair<std::size_t, std::string_view>> matched;
+        result = parallel_search_terms(automaton, file.view(), threads, print_matches ? &matched : nullptr);
+        for (const auto &match: matched)
+            print(match.first, match.second);
+    } else if (print_matches) {
+        result = automaton.search(file.view(), print);
+    } else {
+        result = automaton.search(file.view());
+    }
+    
+    std::cout << result.words << " words were searched for " << terms.size() << " terms..." << std::endl;
+    for (std::size_t t = 0; t < terms.size(); ++t)
+        std::cout << "The substring " << terms[t] << " was found " << result.matches[t] << " times " << std::endl;
+    return 0;
+}
+
+// Word frequencies over the mapped file, and the k most frequent words
+int count_frequencies(const std::string &path, std::size_t k, std::size_t threads) {
+    Mapped_File file {path};
+    if (!file) {
+        std::cerr << "Problem opening file" << std::endl;
+        return 1;
+    }
+    
+    Word_Counts counts = parallel_count_words(file.view(), threads);
+    
+    std::cout << counts.total() << " words were counted, " << counts.distinct() << " different ones" << std::endl;
+    std::cout << "The " << k << " most frequent:" << std::endl;
+    for (const Word_Count &entry: counts.top(k)) {
+        std::cout.write(entry.word.data(), entry.word.size());
+        std::cout << " " << entry.count << std::endl;
+    }
+    return 0;
+}
+
+// true if text is a whole number, stored in value - "8" but not "-1", "8x" or ""
+bool parse_count(const std::string &text, std::size_t &value) {
+    const char *last = text.data() + text.size();
+    auto result = std::from_chars(text.data(), last, value);
+    return result.ec == std::errc{} && result.ptr == last;
+}
+
+int main(int argc, char *argv[]) {
+    std::string mode = (argc > 1) ? argv[1] : "";
+    bool print_matches {false};
+    std::size_t threads {1};
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg {argv[i]};
+        if (arg == "--matches")
+            print_matches = true;
+        else if (arg == "--threads") {
+            if (i + 1 == argc || !parse_count(argv[++i], threads) || threads == 0) {
+                std::cerr << "Usage: word_counter [--mmap [file] | --terms terms.txt [file] [--matches] | --top K [file]] [--threads N]" << std::endl;
+                return 1;
+            }
+        } else
+            paths.push_back(arg);
+    }
+    
+    if (mode == "--terms") {
+        if (paths.empty()) {
+            std::cerr << "Usage: word_counter --terms terms.txt [file] [--matches] [--threads N]" << std::endl;
+            return 1;
+        }
+        return search_terms((paths.size() > 1) ? paths[1] : "../romeoandjuliet.txt", paths[0], print_matches, threads);
+    }
+    
+    if (mode == "--top") {
+        std::size_t k {0};
+        if (paths.empty() || !parse_count(paths[0], k)) {
+            std::cerr << "Usage: word_counter --top K [file] [--threads N]" << std::endl;
+            return 1;
+        }
+        return count_frequencies((paths.size() > 1) ? paths[1] : "../romeoandjuliet.txt", k, threads);
+    }
+    
+    bool mapped = (mode == "--mmap");
+    std::string path = (mapped && !paths.empty()) ? paths[0] : "../romeoandjuliet.txt";
+    std::string word_to_find {};
+    
+    std::cout << "Enter the substring to search for: ";
+    std::cin >> word_to_find;
+    
+    int status = mapped ? search_mapped(path, word_to_find, threads) : search_stream(path, word_to_find);
+    std::cout << std::endl;
+    return status;
+}
@@ -0,0 +1,157 @@
+// Word counter benchmark harness
+// Builds a large file out of copies of the play, then searches it for one word and for a list
+// of terms on 1, 2, 4 and 8 threads, next to the lesson's in_file >> word loop, then counts
+// word frequencies with Word_Counts next to a std::unordered_map<std::string, int> - checking
+// that every run finds the same counts.
+//
+// Build against the Challenge_3_Solution word counter with optimizations on, e.g.
+//   g++ -std=c++17 -O2 -pthread -I../Challenge_3_Solution main.cpp ../Challenge_3_Solution/Word_Search.cpp ../Challenge_3_Solution/Term_Search.cpp ../Challenge_3_Solution/Word_Frequency.cpp ../Challenge_3_Solution/Parallel_Search.cpp ../Challenge_3_Solution/Mapped_File.cpp -o bench
+// Run ./bench [copies] from this directory - 1000 copies (144 MB) by default. The file is
+// written to the temporary directory and removed afterwards.
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Mapped_File.h"
+#include "Word_Search.h"
+#include "Term_Search.h"
+#include "Word_Frequency.h"
+#include "Parallel_Search.h"
+
+using namespace std;
+
+template <typename Func>
+double time_s(Func f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    int copies = (argc > 1) ? stoi(argv[1]) : 1000;
+    
+    ifstream play_file {"../Challenge_3_Solution/romeoandjuliet.txt"};
+    if (!play_file) {
+        cerr << "Problem opening ../Challenge_3_Solution/romeoandjuliet.txt" << endl;
+        return 1;
+    }
+    stringstream play;
+    play << play_file.rdbuf();
+    
+    string path = (filesystem::temp_directory_path() / "word_counter_bench.txt").string();
+    {
+        ofstream out {path, ios::binary};
+        for (int i=0; i<copies; i++)
+            out << play.str();
+    }
+    double megabytes = static_cast<double>(filesystem::file_size(path)) / 1e6;
+    
+    cout << "=== " << copies << " copies of the play (" << fixed << setprecision(0) << megabytes << " MB), "
+         << thread::hardware_concurrency() << " hardware threads ===" << endl;
+    
+    auto report = [&](const string &name, double s, double base_s) {
+        cout << setw(40) << left << name << right << fixed << setprecision(1)
+             << setw(10) << s * 1000 << " ms" << setw(10) << setprecision(0) << megabytes / s << " MB/s"
+             << setw(8) << setprecision(2) << base_s / s << "x" << endl;
+    };
+    
+    Mapped_File file {path};
+    const string word {"Juliet"};
+    
+    // The lesson's loop
+    size_t stream_words {0}, stream_matches {0};
+    double stream_s = time_s([&]() {
+        ifstream in_file {path};
+        string word_read;
+        while (in_file >> word_read) {
+            ++stream_words;
+            stream_matches += word_read.find(word) != string::npos;
+        }
+    });
+    report("in_file >> word, find", stream_s, stream_s);
+    
+    // One word, mapped
+    Search_Result single;
+    double single_s = time_s([&]() { single = search_words(file.view(), word, [](string_view) {}); });
+    report("mapped, 1 thread", single_s, single_s);
+    bool same = single.words == stream_words && single.matches == stream_matches;
+    for (size_t threads: {2, 4, 8}) {
+        Search_Result result;
+        double s = time_s([&]() { result = parallel_search_words(file.view(), word, threads); });
+        report("mapped, " + to_string(threads) + " threads", s, single_s);
+        same = same && result.words == single.words && result.matches == single.matches;
+    }
+    cout << "Same counts as in_file >> word: " << boolalpha << same << endl;
+    
+    // Every distinct word of the play's first 2000 words as terms
+    vector<string> terms;
+    {
+        istringstream in {play.str()};
+        string w;
+        for (int i=0; i<2000 && in >> w; i++)
+            terms.push_back(w);
+        sort(terms.begin(), terms.end());
+        terms.erase(unique(terms.begin(), terms.end()), terms.end());
+    }
+    Term_Automaton automaton {terms};
+    cout << "\n--- " << terms.size() << " terms ---" << endl;
+    Term_Result base;
+    double base_s = time_s([&]() { base = automaton.search(file.view()); });
+    report("terms, 1 thread", base_s, base_s);
+    same = true;
+    for (size_t threads: {2, 4, 8}) {
+        Term_Result result;
+        double s = time_s([&]() { result = parallel_search_terms(automaton, file.view(), threads); });
+        report("terms, " + to_string(threads) + " threads", s, base_s);
+        same = same && result.words == base.words && result.matches == base.matches;
+    }
+    cout << "Same counts on every thread count: " << boolalpha << same << endl;
+    
+    // Word frequencies - a string per word and a node per distinct word, folded the same way
+    cout << "\n--- word frequencies ---" << endl;
+    unordered_map<string, size_t> map_counts;
+    double map_s = time_s([&]() {
+        ifstream in_file {path};
+        string word_read;
+        while (in_file >> word_read) {
+            size_t begin = word_read.find_first_not_of("!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~");
+            size_t end = word_read.find_last_not_of("!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~");
+            if (begin == string::npos)
+                continue;
+            string word = word_read.substr(begin, end - begin + 1);
+            for (char &c: word)
+                c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+            ++map_counts[word];
+        }
+    });
+    report("in_file >> word, unordered_map", map_s, map_s);
+    Word_Counts frequencies;
+    double counts_s = time_s([&]() { frequencies = parallel_count_words(file.view(), 1); });
+    report("Word_Counts, 1 thread", counts_s, map_s);
+    same = frequencies.distinct() == map_counts.size();
+    for (const auto &entry: map_counts)
+        same = same && frequencies.count(entry.first) == entry.second;
+    for (size_t threads: {2, 4, 8}) {
+        Word_Counts merged;
+        double s = time_s([&]() { merged = parallel_count_words(file.view(), threads); });
+        report("Word_Counts, " + to_string(threads) + " threads", s, map_s);
+        auto top = merged.top(10);
+        auto expected = frequencies.top(10);
+        same = same && merged.total() == frequencies.total() && merged.distinct() == frequencies.distinct() 
+               && equal(top.begin(), top.end(), expected.begin(), expected.end(), [](const Word_Count &a, const Word_Count &b) {
+                      return a.word == b.word && a.count == b.count;
+                  });
+    }
+    cout << "Same counts as unordered_map and on every thread count: " << boolalpha << same << endl;
+    
+    remove(path.c_str());
+    return 0;
+}
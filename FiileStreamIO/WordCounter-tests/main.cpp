@@ -0,0 +1,283 @@
+// Word counter tests
+// Checks the word counter's searches and word frequencies against the lesson's own way of
+// reading words - istringstream >> word, then find on each word - on generated texts of every
+// length up to a few 16-byte blocks, with all six whitespace chars, runs of whitespace at either
+// end, punctuation and non-ASCII bytes, and needles and terms that are empty, whitespace only,
+// longer than a block or not ASCII. Then runs the parallel searches and counts on several
+// thread counts and checks they find the same as one thread.
+//
+// Build against the Challenge_3_Solution word counter, e.g.
+//   g++ -std=c++17 -pthread -I../Challenge_3_Solution main.cpp ../Challenge_3_Solution/Word_Search.cpp ../Challenge_3_Solution/Term_Search.cpp ../Challenge_3_Solution/Word_Frequency.cpp ../Challenge_3_Solution/Parallel_Search.cpp -o tests
+// ./tests prints every failed check and exits with 1 if there was one.
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Word_Search.h"
+#include "Term_Search.h"
+#include "Word_Frequency.h"
+#include "Parallel_Search.h"
+
+static int failures {0};
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        std::cout << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Reference versions - one std::string per word, read with >>
+
+static std::vector<std::string> words_of(std::string_view text) {
+    std::istringstream in {std::string{text}};
+    std::vector<std::string> words;
+    std::string word;
+    while (in >> word)
+        words.push_back(word);
+    return words;
+}
+
+// Words containing needle, in text order
+static std::vector<std::string> naive_matches(const std::vector<std::string> &words, std::string_view needle) {
+    std::vector<std::string> matched;
+    for (const auto &word: words)
+        if (word.find(needle) != std::string::npos)
+            matched.push_back(word);
+    return matched;
+}
+
+// Words trimmed of punctuation and folded to lowercase, as Word_Counts counts them
+static std::map<std::string, std::size_t> naive_counts(const std::vector<std::string> &words) {
+    const char *punct = "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+    std::map<std::string, std::size_t> counts;
+    for (const auto &read: words) {
+        std::size_t begin = read.find_first_not_of(punct);
+        if (begin == std::string::npos)
+            continue;
+        std::string word = read.substr(begin, read.find_last_not_of(punct) - begin + 1);
+        for (char &c: word)
+            c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+        ++counts[word];
+    }
+    return counts;
+}
+
+static std::vector<std::string> to_strings(const std::vector<std::string_view> &views) {
+    return std::vector<std::string>(views.begin(), views.end());
+}
+
+// (term, word) pairs sorted, so matches found in a different order within a word compare equal
+static std::vector<std::pair<std::size_t, std::string>> sorted_pairs(const std::vector<std::pair<std::size_t, std::string_view>> &found) {
+    std::vector<std::pair<std::size_t, std::string>> pairs;
+    for (const auto &[term, word]: found)
+        pairs.emplace_back(term, std::string{word});
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+// Generated texts: a fixed pseudo-random sequence, so a failure happens the same way every run
+class Text_Maker {
+private:
+    std::uint64_t state {0x2545F4914F6CDD1Dull};
+public:
+    std::size_t next(std::size_t bound) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<std::size_t>(state % bound);
+    }
+
+    // length chars, mostly short words of a few letters so needles match often
+    std::string text(std::size_t length) {
+        static const std::string_view pieces[] = {
+            "a", "b", "ab", "A", "B", "the", "The", "THE", ",", "'", "!", "\xC3\xA9", "\xFF", "\x80",
+            " ", " ", " ", "  ", "\t", "\n", "\v", "\f", "\r", "\r\n"
+        };
+        std::string result;
+        while (result.size() < length)
+            result += pieces[next(sizeof pieces / sizeof pieces[0])];
+        result.resize(length);
+        return result;
+    }
+};
+
+static const std::vector<std::string> needles {
+    "a", "ab", "ba", "the", "The", "\xC3\xA9", "\xA9", "\xFF", "a'", ",a",
+    "", " ", "\t", " \n ", "a b", "abababababababababab"
+};
+
+// search_words on generated texts of every length up to five 16-byte blocks
+static void test_search_words() {
+    Text_Maker maker;
+    for (std::size_t length = 0; length <= 80; ++length) {
+        for (int round = 0; round < 20; ++round) {
+            std::string text = maker.text(length);
+            std::vector<std::string> words = words_of(text);
+            for (const auto &needle: needles) {
+                std::vector<std::string_view> found;
+                Search_Result result = search_words(text, needle, [&](std::string_view word) { found.push_back(word); });
+                std::vector<std::string> expected = needle.find_first_of(" \t\n\v\f\r") == std::string::npos ? naive_matches(words, needle) : std::vector<std::string>{};
+                check(result.words == words.size(), "search_words word count");
+                check(result.matches == expected.size(), "search_words match count");
+                check(to_strings(found) == expected, "search_words matched words");
+            }
+        }
+    }
+}
+
+// A needle and the words around it at every offset from a block edge
+static void test_block_edges() {
+    for (std::size_t pad = 0; pad <= 48; ++pad) {
+        for (const char *space: {" ", "\t", "\r\n"}) {
+            std::string text = std::string(pad, 'x') + space + "xxabcxx" + space + std::string(pad, 'a') + "bc";
+            std::vector<std::string> words = words_of(text);
+            for (std::string_view needle: {"abc", "xab", "x", "abcabcabcabcabcabcabc"}) {
+                std::vector<std::string_view> found;
+                Search_Result result = search_words(text, needle, [&](std::string_view word) { found.push_back(word); });
+                check(result.words == words.size(), "word count at a block edge");
+                check(to_strings(found) == naive_matches(words, needle), "matches at a block edge");
+            }
+        }
+    }
+}
+
+// One Term_Automaton pass finds what search_words finds for each term on its own; terms with
+// whitespace and the empty term find nothing
+static void test_term_automaton() {
+    std::vector<std::string> terms {
+        "a", "ab", "b", "bab", "the", "he", "e", "THE", "\xC3\xA9", "\xFF", "a'", "ab",
+        "", " ", "a b", "abababababababababab"
+    };
+    Term_Automaton automaton {terms};
+    check(automaton.size() == terms.size(), "term count");
+    Text_Maker maker;
+    for (std::size_t length = 0; length <= 80; ++length) {
+        for (int round = 0; round < 10; ++round) {
+            std::string text = maker.text(length);
+            std::vector<std::string> words = words_of(text);
+            std::vector<std::pair<std::size_t, std::string_view>> found;
+            Term_Result result = automaton.search(text, [&](std::size_t term, std::string_view word) { found.emplace_back(term, word); });
+            check(result.words == words.size(), "automaton word count");
+            bool counts_match = result.matches.size() == terms.size();
+            std::vector<std::pair<std::size_t, std::string>> expected;
+            for (std::size_t t = 0; t < terms.size() && counts_match; ++t) {
+                bool searchable = !terms[t].empty() && terms[t].find_first_of(" \t\n\v\f\r") == std::string::npos;
+                std::vector<std::string> matched = searchable ? naive_matches(words, terms[t]) : std::vector<std::string>{};
+                counts_match = result.matches[t] == matched.size();
+                for (auto &word: matched)
+                    expected.emplace_back(t, word);
+            }
+            std::sort(expected.begin(), expected.end());
+            check(counts_match, "automaton count per term");
+            check(sorted_pairs(found) == expected, "automaton matched words");
+            check(automaton.search(text).matches == result.matches, "automaton counts without a callback");
+        }
+    }
+}
+
+// Word_Counts::top against sorting the reference counts
+static void check_top(const Word_Counts &counts, const std::map<std::string, std::size_t> &expected, std::size_t k) {
+    std::vector<std::pair<std::string, std::size_t>> ranked(expected.begin(), expected.end());
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) { return a.second > b.second; });
+    ranked.resize(std::min(k, ranked.size()));
+    std::vector<Word_Count> top = counts.top(k);
+    bool same = top.size() == ranked.size();
+    for (std::size_t i = 0; i < top.size() && same; ++i)
+        same = top[i].word == ranked[i].first && top[i].count == ranked[i].second;
+    check(same, "top k");
+}
+
+static void check_counts(const Word_Counts &counts, const std::map<std::string, std::size_t> &expected, const char *what) {
+    std::size_t total {0};
+    bool same = counts.distinct() == expected.size();
+    for (const auto &[word, count]: expected) {
+        total += count;
+        same = same && counts.count(word) == count;
+    }
+    check(same && counts.total() == total, what);
+}
+
+// Word frequencies on short texts, and on one with enough distinct words to grow the table
+static void test_word_counts() {
+    Text_Maker maker;
+    for (std::size_t length = 0; length <= 80; ++length) {
+        std::string text = maker.text(length);
+        std::map<std::string, std::size_t> expected = naive_counts(words_of(text));
+        Word_Counts counts;
+        counts.add(text);
+        check_counts(counts, expected, "word counts");
+        check(counts.count("THE") == counts.count("the") && counts.count("'the!") == counts.count("the"), "count folds its argument");
+        for (std::size_t k: {0, 1, 2, 5, 100})
+            check_top(counts, expected, k);
+    }
+
+    std::string text;
+    for (int i = 0; i < 5000; ++i)
+        text += "Word" + std::to_string(i % 1500) + ((i % 3 == 0) ? ", " : "\n");
+    std::map<std::string, std::size_t> expected = naive_counts(words_of(text));
+    Word_Counts counts;
+    counts.add(text);
+    check_counts(counts, expected, "word counts with the table grown");
+    check_top(counts, expected, 10);
+}
+
+// The parallel versions find the same on every thread count, with matches in text order
+static void test_parallel() {
+    Text_Maker maker;
+    std::string text = maker.text(5000);
+    std::vector<std::string> words = words_of(text);
+    std::map<std::string, std::size_t> expected_counts = naive_counts(words);
+    std::vector<std::string> terms {"a", "ab", "the", "\xC3\xA9", "", " "};
+    Term_Automaton automaton {terms};
+    std::vector<std::pair<std::size_t, std::string_view>> one_thread;
+    Term_Result expected_terms = automaton.search(text, [&](std::size_t term, std::string_view word) { one_thread.emplace_back(term, word); });
+
+    for (std::size_t threads: {1, 2, 3, 4, 7, 8, 64}) {
+        std::vector<std::string_view> ranges = split_at_words(text, threads);
+        std::string joined;
+        for (std::string_view range: ranges)
+            joined += range;
+        check(ranges.size() == threads && joined == text, "split_at_words covers the text in order");
+
+        for (const auto &needle: {std::string{"ab"}, std::string{"the"}, std::string{""}, std::string{" "}}) {
+            std::vector<std::string_view> matched;
+            Search_Result result = parallel_search_words(text, needle, threads, &matched);
+            std::vector<std::string> expected = (needle == " ") ? std::vector<std::string>{} : naive_matches(words, needle);
+            check(result.words == words.size() && result.matches == expected.size(), "parallel_search_words counts");
+            check(to_strings(matched) == expected, "parallel_search_words matches in text order");
+        }
+
+        std::vector<std::pair<std::size_t, std::string_view>> found;
+        Term_Result result = parallel_search_terms(automaton, text, threads, &found);
+        check(result.words == expected_terms.words && result.matches == expected_terms.matches, "parallel_search_terms counts");
+        check(found == one_thread, "parallel_search_terms matches in text order");
+
+        Word_Counts counts = parallel_count_words(text, threads);
+        check_counts(counts, expected_counts, "parallel_count_words");
+        check_top(counts, expected_counts, 20);
+    }
+
+    // More threads than words
+    check(parallel_search_words("a b", "a", 8).matches == 1 && parallel_count_words("", 4).total() == 0, "tiny texts on many threads");
+}
+
+int main() {
+    test_search_words();
+    test_block_edges();
+    test_term_automaton();
+    test_word_counts();
+    test_parallel();
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,399 @@
+// Account benchmark harness
+// Runs transfers between accounts from several threads at once, with a few hot accounts
+// (heavy contention) and with many accounts (little contention), comparing transfers that
+// each take one global mutex with Transaction's ordered, striped locking. Then times
+// declined withdrawals and openings through the throwing API and the Account_Status one,
+// prints a million-account statement through std::ostream and through Print_Buffer, and
+// accrues interest on a few million accounts with Interest_Engine at 1, 2 and 4 threads,
+// and runs batch deposits and withdrawals over Account_Store's objects and Account_Table's
+// hot/cold arrays.
+//
+// Build against the ChallengeSolution accounts with optimizations on, e.g.
+//   g++ -std=c++20 -O2 -pthread -I../ChallengeSolution main.cpp ../ChallengeSolution/Account.cpp ../ChallengeSolution/Savings_Account.cpp ../ChallengeSolution/Checking_Account.cpp ../ChallengeSolution/Trust_Account.cpp ../ChallengeSolution/I_Printable.cpp ../ChallengeSolution/Money.cpp ../ChallengeSolution/Transaction.cpp ../ChallengeSolution/Print_Buffer.cpp ../ChallengeSolution/Account_Store.cpp ../ChallengeSolution/Interest_Engine.cpp ../ChallengeSolution/Account_Table.cpp ../ChallengeSolution/Account_Kernels.cpp -o bench
+// Run ./bench for everything, or ./bench transfers, declined, statements, interest
+// or layout for one part.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+#include "Print_Buffer.h"
+#include "Transaction.h"
+#include "Account_Store.h"
+#include "Interest_Engine.h"
+#include "Account_Table.h"
+#include <cmath>
+
+using namespace std;
+
+// Small, fast random numbers for picking accounts - one generator per thread
+struct Xorshift {
+    uint64_t state;
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// Runs f(thread_index) on threads threads at once and returns the wall time in seconds
+template <typename Func>
+double run_threads(int threads, Func f) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t=0; t<threads; t++)
+        workers.emplace_back(f, t);
+    for (auto &w: workers)
+        w.join();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double>(stop - start).count();
+}
+
+Money total_of(const vector<Savings_Account> &accounts) {
+    Money total;
+    for (const auto &acc: accounts)
+        total += acc.get_balance();
+    return total;
+}
+
+// Every transfer moves $1 between two different random accounts; the total must not change
+void transfer_benchmarks() {
+    const long transfers_per_thread {200000};
+    const Money opening {1000000.0};
+    
+    cout << "\n=== Transfers (" << transfers_per_thread << " per thread) ==================================" << endl;
+    cout << setw(10) << left << "accounts" << setw(9) << "threads" << right
+         << setw(16) << "global mutex" << setw(16) << "transaction" << setw(10) << "ratio" 
+         << setw(12) << "balanced" << endl;
+    
+    for (int account_count : {4, 4096}) {
+        for (int threads : {1, 2, 4, 8}) {
+            vector<Savings_Account> accounts(account_count, Savings_Account{"Bench", opening});
+            const Money expected = total_of(accounts);
+            
+            mutex global;
+            double global_s = run_threads(threads, [&](int t) {
+                Xorshift rng {0x9e3779b97f4a7c15ull * (t + 1)};
+                for (long i=0; i<transfers_per_thread; i++) {
+                    size_t from = rng.next() % account_count;
+                    size_t to = (from + 1 + rng.next() % (account_count - 1)) % account_count;
+                    lock_guard<mutex> lock {global};
+                    if (accounts[from].withdraw(1.0))
+                        accounts[to].deposit(1.0);
+                }
+            });
+            bool balanced = total_of(accounts) == expected;
+            
+            double transaction_s = run_threads(threads, [&](int t) {
+                Xorshift rng {0x9e3779b97f4a7c15ull * (t + 1)};
+                for (long i=0; i<transfers_per_thread; i++) {
+                    size_t from = rng.next() % account_count;
+                    size_t to = (from + 1 + rng.next() % (account_count - 1)) % account_count;
+                    transfer(accounts[from], accounts[to], 1.0);
+                }
+            });
+            balanced = balanced && total_of(accounts) == expected;
+            
+            double count = static_cast<double>(transfers_per_thread) * threads;
+            cout << setw(10) << left << account_count << setw(9) << threads << right << fixed << setprecision(2)
+                 << setw(12) << count / global_s / 1e6 << " M/s"
+                 << setw(12) << count / transaction_s / 1e6 << " M/s"
+                 << setw(9) << global_s / transaction_s << "x"
+                 << setw(12) << boolalpha << balanced << endl;
+        }
+    }
+}
+
+// Stops the optimizer from throwing away results
+static volatile long sink {0};
+
+// Runs f ops times and returns the average time per run in nanoseconds
+template <typename Func>
+double time_ns(long ops, Func f) {
+    f();        // warm up
+    auto start = chrono::steady_clock::now();
+    for (long i=0; i<ops; i++)
+        f();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(stop - start).count() / ops;
+}
+
+void compare(const string &name, double throwing_ns, double status_ns) {
+    cout << setw(34) << left << name << right << fixed << setprecision(1)
+         << setw(10) << throwing_ns << " ns" << setw(10) << status_ns << " ns"
+         << setw(10) << setprecision(2) << throwing_ns / status_ns << "x" 
+         << setw(12) << setprecision(2) << 1000.0 / status_ns << " M/s" << endl;
+}
+
+// Every withdrawal here is declined for insufficient funds - the routine outcome that the
+// throwing API reports with InsufficientFundsException
+void declined_benchmarks() {
+    const long ops {200000};
+    
+    cout << "\n=== Declined operations (" << ops << " runs each) =========================" << endl;
+    cout << setw(34) << "" << setw(13) << "throwing" << setw(13) << "status" << setw(11) << "ratio"
+         << setw(16) << "status rate" << endl;
+    
+    Savings_Account savings {"Empty", 10.0};
+    compare("Savings withdrawal, no funds",
+        time_ns(ops, [&]() {
+            try {
+                sink = sink + savings.withdraw(100.0);
+            }
+            catch (const InsufficientFundsException &ex) {
+                sink = sink + 1;
+            }
+        }),
+        time_ns(ops, [&]() { 
+            sink = sink + static_cast<long>(savings.try_withdraw(100.0)); 
+        }));
+    
+    Checking_Account checking {"Empty", 1.0};
+    compare("Checking withdrawal, fee > funds",
+        time_ns(ops, [&]() {
+            try {
+                sink = sink + checking.withdraw(1.0);
+            }
+            catch (const InsufficientFundsException &ex) {
+                sink = sink + 1;
+            }
+        }),
+        time_ns(ops, [&]() { 
+            sink = sink + static_cast<long>(checking.try_withdraw(1.0)); 
+        }));
+    
+    compare("open with negative balance",
+        time_ns(ops, [&]() {
+            try {
+                Savings_Account acc {"Larry", -2000.0};
+                sink = sink + 1;
+            }
+            catch (const IllegalBalanceException &ex) {
+                sink = sink + 2;
+            }
+        }),
+        time_ns(ops, [&]() {
+            auto acc = make_account<Savings_Account>("Larry", -2000.0);
+            sink = sink + static_cast<long>(acc.status());
+        }));
+    
+    // Under contention the unwinder's global state makes throwing worse still
+    for (int threads : {2, 4}) {
+        long per_thread = ops / threads;
+        vector<Savings_Account> accounts(threads, Savings_Account{"Empty", 10.0});
+        double throwing_s = run_threads(threads, [&](int t) {
+            for (long i=0; i<per_thread; i++) {
+                try {
+                    accounts[t].withdraw(100.0);
+                }
+                catch (const InsufficientFundsException &ex) {
+                }
+            }
+        });
+        double status_s = run_threads(threads, [&](int t) {
+            for (long i=0; i<per_thread; i++)
+                sink = sink + static_cast<long>(accounts[t].try_withdraw(100.0));
+        });
+        compare("withdrawal, no funds, " + to_string(threads) + " threads", 
+                throwing_s * 1e9 / ops, status_s * 1e9 / ops);
+    }
+}
+
+// A statement of every account written to /dev/null, so the time is formatting and the
+// write calls rather than the disk
+void statement_benchmarks() {
+    const int account_count {1000000};
+    
+    cout << "\n=== Statements (" << account_count << " accounts) ================================" << endl;
+    
+    vector<Savings_Account> savings;
+    vector<Trust_Account> trust;
+    savings.reserve(account_count / 2);
+    trust.reserve(account_count / 2);
+    for (int i=0; i<account_count / 2; i++) {
+        savings.emplace_back("Savings " + to_string(i), Money::from_cents(i * 37), 2.5);
+        trust.emplace_back("Trust " + to_string(i), Money::from_cents(i * 91), 4.0);
+    }
+    
+    auto report = [](const string &name, double s) {
+        cout << setw(40) << left << name << right << fixed << setprecision(1)
+             << setw(10) << s * 1000 << " ms" << setw(10) << setprecision(0) << account_count / s / 1e3 << " K/s" << endl;
+    };
+    
+    {
+        ofstream null {"/dev/null"};
+        auto start = chrono::steady_clock::now();
+        for (const auto &acc: savings)
+            null << acc << endl;
+        for (const auto &acc: trust)
+            null << acc << endl;
+        report("ostream, endl per account", chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    {
+        ofstream null {"/dev/null"};
+        auto start = chrono::steady_clock::now();
+        for (const auto &acc: savings)
+            null << acc << '\n';
+        for (const auto &acc: trust)
+            null << acc << '\n';
+        null.flush();
+        report("ostream, '\\n' per account", chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    {
+        ofstream null {"/dev/null"};
+        auto start = chrono::steady_clock::now();
+        Print_Buffer out {null};
+        for (const auto &acc: savings)
+            out << acc << '\n';
+        for (const auto &acc: trust)
+            out << acc << '\n';
+        out.flush();
+        null.flush();
+        report("Print_Buffer", chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    
+    // Both paths must produce the same text
+    ostringstream streamed;
+    for (int i=0; i<1000; i++)
+        streamed << savings[i] << '\n' << trust[i] << '\n';
+    ostringstream buffered;
+    {
+        Print_Buffer out {buffered};
+        for (int i=0; i<1000; i++)
+            out << savings[i] << '\n' << trust[i] << '\n';
+    }
+    cout << "Print_Buffer matches ostream: " << boolalpha << (streamed.str() == buffered.str()) << endl;
+}
+
+// A month of interest on every Savings and Trust account, compared with a plain loop that works
+// out each account's growth factor and interest one at a time
+void interest_benchmarks() {
+    const int account_count {4000000};
+    
+    cout << "\n=== Interest (" << account_count << " accounts) ==================================" << endl;
+    
+    Account_Store store;
+    Xorshift rng {0x1234567};
+    const double rates[] {1.5, 2.5, 3.0, 4.0};
+    for (int i=0; i<account_count / 2; i++) {
+        store.add(Savings_Account {"", Money::from_cents(rng.next() % 100000000), rates[i / 1000 % 4]});
+        store.add(Trust_Account {"", Money::from_cents(rng.next() % 300000000), rates[i / 1000 % 4]});
+    }
+    
+    auto report = [](const string &name, double s) {
+        cout << setw(40) << left << name << right << fixed << setprecision(1)
+             << setw(10) << s * 1000 << " ms" << setw(10) << setprecision(0) << account_count / s / 1e6 << " M/s" << endl;
+    };
+    
+    // Plain loop - pow and a rounded multiply per account, balances kept aside
+    vector<Money> expected;
+    expected.reserve(account_count);
+    auto start = chrono::steady_clock::now();
+    for (const auto &acc: store.get_savings()) {
+        double factor = pow(1 + acc.get_int_rate() / 100 / 12, 1) - 1;
+        expected.push_back(acc.get_balance() + Money::from_cents(nearbyint(acc.get_balance().get_cents() * factor)));
+    }
+    for (const auto &acc: store.get_trust()) {
+        double factor = pow(1 + acc.get_int_rate() / 100 / 12, 1) - 1;
+        Money interest = Money::from_cents(nearbyint(acc.get_balance().get_cents() * factor));
+        expected.push_back(acc.get_balance() + interest + ((interest >= 5000) ? Money {50} : Money {}));
+    }
+    report("plain loop", chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    
+    for (int threads: {1, 2, 4}) {
+        Account_Store copy {store};
+        Interest_Engine engine {static_cast<size_t>(threads)};
+        Accrual_Result result = engine.accrue(copy, 12);
+        report("Interest_Engine, " + to_string(threads) + " threads", result.seconds);
+        
+        size_t i {0};
+        bool same {true};
+        for (const auto &acc: copy.get_savings())
+            same = same && acc.get_balance() == expected[i++];
+        for (const auto &acc: copy.get_trust())
+            same = same && acc.get_balance() == expected[i++];
+        cout << "    matches plain loop: " << boolalpha << same << ", " << result.bonuses << " bonuses" << endl;
+    }
+}
+
+// Batch deposits and withdrawals over the same accounts in both layouts. The names are long
+// enough to need a heap block each, as real names usually do.
+void layout_benchmarks() {
+    const int account_count {3000000};
+    const int rounds {10};
+    
+    cout << "\n=== Layout (" << account_count << " accounts, " << rounds << " deposit + withdraw rounds) ========" << endl;
+    
+    Account_Store store;
+    Account_Table table;
+    for (auto kind: {Account_Kind::savings, Account_Kind::checking, Account_Kind::trust})
+        table.reserve(kind, account_count / 3);
+    for (int i=0; i<account_count / 3; i++) {
+        string name = "Customer account number " + to_string(i);
+        Money balance = Money::from_cents(i % 100000 * 100);
+        store.add(Savings_Account {name, balance, 2.5});
+        store.add(Checking_Account {name, balance});
+        store.add(Trust_Account {name, balance, 4.0});
+        table.open(Account_Kind::savings, name, balance, 2.5);
+        table.open(Account_Kind::checking, name, balance);
+        table.open(Account_Kind::trust, name, balance, 4.0);
+    }
+    
+    auto report = [&](const string &name, double s) {
+        cout << setw(40) << left << name << right << fixed << setprecision(1)
+             << setw(10) << s * 1000 << " ms" << setw(10) << setprecision(0) 
+             << 2.0 * rounds * account_count / s / 1e6 << " M updates/s" << endl;
+    };
+    
+    size_t store_done {0};
+    auto start = chrono::steady_clock::now();
+    for (int r=0; r<rounds; r++)
+        store_done += store.deposit_all(10) + store.withdraw_all(25);
+    report("Account_Store (objects)", chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    
+    size_t table_done {0};
+    start = chrono::steady_clock::now();
+    for (int r=0; r<rounds; r++)
+        table_done += table.deposit_all(10) + table.withdraw_all(25);
+    report("Account_Table (hot/cold arrays)", chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    
+    // Every account must end up with the same balance either way
+    Money store_total, table_total;
+    for (const auto &acc: store.get_savings())
+        store_total += acc.get_balance();
+    for (const auto &acc: store.get_checking())
+        store_total += acc.get_balance();
+    for (const auto &acc: store.get_trust())
+        store_total += acc.get_balance();
+    for (Account_Id id=0; id<table.size(); id++)
+        table_total += table.get_balance(id);
+    cout << "Account_Table matches Account_Store: " << boolalpha 
+         << (store_done == table_done && store_total == table_total) << endl;
+    cout << "bytes per account: " << sizeof(Savings_Account) << " (Savings_Account), " 
+         << sizeof(Money) + sizeof(double) << " hot (Account_Table Savings)" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    string part = (argc > 1) ? argv[1] : "all";
+    if (part == "all" || part == "transfers")
+        transfer_benchmarks();
+    if (part == "all" || part == "declined")
+        declined_benchmarks();
+    if (part == "all" || part == "statements")
+        statement_benchmarks();
+    if (part == "all" || part == "interest")
+        interest_benchmarks();
+    if (part == "all" || part == "layout")
+        layout_benchmarks();
+    return 0;
+}
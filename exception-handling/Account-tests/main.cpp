@@ -0,0 +1,406 @@
+// Account tests
+// Checks Money's rounding, formatting and overflow checks at the int64 limits. Runs batch
+// deposits and withdrawals over an Account_Book with a Ledger as their Audit_Sink, then
+// replays the ledger and checks every account's ledger balance against its real one - on
+// accounts the ledger has never seen, after interest, bonuses and fees, and after the book's
+// vector has reallocated under the ledger. Checks the batch results' counts and amounts and
+// the CSV audit sink's quoting, and that a transaction with a failing leg puts back every
+// account it touched. Then hammers single accounts from several threads with concurrent
+// updates enabled (build with -fsanitize=thread to check them too), and checks Trust
+// withdrawal rate limits at fixed points in time and through every path that withdraws -
+// single accounts, transactions, Account_Store and Account_Table.
+//
+// Build against the ChallengeSolution accounts, e.g.
+//   g++ -std=c++20 -pthread -I../ChallengeSolution main.cpp ../ChallengeSolution/Account.cpp ../ChallengeSolution/Savings_Account.cpp ../ChallengeSolution/Checking_Account.cpp ../ChallengeSolution/Trust_Account.cpp ../ChallengeSolution/I_Printable.cpp ../ChallengeSolution/Money.cpp ../ChallengeSolution/Print_Buffer.cpp ../ChallengeSolution/Account_Book.cpp ../ChallengeSolution/Account_Util.cpp ../ChallengeSolution/Audit_Sink.cpp ../ChallengeSolution/Ledger.cpp ../ChallengeSolution/Transaction.cpp ../ChallengeSolution/Account_Store.cpp ../ChallengeSolution/Account_Table.cpp ../ChallengeSolution/Account_Kernels.cpp -o tests
+// ./tests prints every failed check and exits with 1 if there was one.
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Account_Book.h"
+#include "Account_Util.h"
+#include "Audit_Sink.h"
+#include "Account_Store.h"
+#include "Account_Table.h"
+#include "Ledger.h"
+#include "Transaction.h"
+
+static int failures {0};
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        std::cout << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Every account the ledger has seen must have the same balance in it as in the book, now and
+// when the ledger is replayed up to now
+static void check_replay(const Account_Book &book, const Ledger &ledger, const char *what) {
+    std::vector<Money> replayed = ledger.replay(ledger.get_time());
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        Ledger::Account_Id id = ledger.id_of(i);
+        check(ledger.balance(id) == book[i].get_balance(), what);
+        check(replayed.at(id) == book[i].get_balance(), what);
+        check(ledger.balance_at(id, ledger.get_time()) == book[i].get_balance(), what);
+    }
+}
+
+static std::string text_of(Money amount) {
+    char buff[Money::max_chars];
+    return std::string(buff, amount.to_chars(buff, buff + sizeof buff));
+}
+
+template <typename Func>
+static bool throws_overflow(Func f) {
+    try {
+        f();
+    }
+    catch (const MoneyOverflowException &) {
+        return true;
+    }
+    return false;
+}
+
+// Doubles round to the nearest cent, halves away from zero
+static void test_money_rounding() {
+    check(Money{12.34}.get_cents() == 1234 && Money{1.999}.get_cents() == 200, "rounding to the nearest cent");
+    check(Money{0.005}.get_cents() == 1 && Money{0.004}.get_cents() == 0, "half a cent rounds up");
+    check(Money{-0.005}.get_cents() == -1 && Money{-0.025}.get_cents() == -3, "negative halves round away from zero");
+    check(Money{0.1} + Money{0.2} == Money{0.3}, "sums are exact");
+    check(Money{100.0} * 0.015 == Money{1.5} && Money{0.1} * 0.5 == Money::from_cents(5), "products round to the nearest cent");
+}
+
+static void test_money_to_chars() {
+    check(text_of(Money{}) == "0.00" && text_of(Money{1000.0}) == "1000.00", "whole amounts");
+    check(text_of(Money::from_cents(7)) == "0.07" && text_of(Money::from_cents(50)) == "0.50", "sub-dollar amounts");
+    check(text_of(Money::from_cents(-5)) == "-0.05" && text_of(Money{-1234.56}) == "-1234.56", "negative amounts");
+    check(text_of(Money::from_cents(std::numeric_limits<std::int64_t>::max())) == "92233720368547758.07", "largest amount");
+    check(text_of(Money::from_cents(std::numeric_limits<std::int64_t>::min())) == "-92233720368547758.08", "smallest amount");
+}
+
+static void test_money_overflow() {
+    Money max = Money::from_cents(std::numeric_limits<std::int64_t>::max());
+    Money min = Money::from_cents(std::numeric_limits<std::int64_t>::min());
+    Money cent = Money::from_cents(1);
+    check(throws_overflow([&]() { max + cent; }) && throws_overflow([&]() { min - cent; }), "sums past the limits throw");
+    check(throws_overflow([&]() { min + -cent; }) && throws_overflow([&]() { max - -cent; }), "sums of negatives past the limits throw");
+    check(throws_overflow([&]() { -min; }), "negating the smallest amount throws");
+    check(throws_overflow([&]() { max * 2.0; }) && throws_overflow([&]() { min * 1.5; }), "products past the limits throw");
+    check(throws_overflow([]() { Money{1e18}; }) && throws_overflow([]() { Money{std::numeric_limits<double>::quiet_NaN()}; }), 
+          "doubles out of range throw");
+    check(!throws_overflow([&]() { max + Money{}; min + max; max - max; -max; }), "sums at the limits don't throw");
+    check(max - cent + cent == max && min + max == -cent, "arithmetic at the limits");
+}
+
+// The first operation on an account opens it at its balance from before the operation
+static void test_first_operation() {
+    Account_Book book;
+    book.open<Checking_Account>("Curly", 100.0);
+    book.open<Savings_Account>("Larry", 100.0, 10.0);
+    Ledger ledger;
+    batch_deposit(book, 50.0, &ledger);
+    check(book[0].get_balance() == Money{150.0}, "checking deposit");
+    check(book[1].get_balance() == Money{155.0}, "savings deposit with interest");
+    check_replay(book, ledger, "first operation");
+}
+
+// Interest, bonuses and fees are recorded with the operation they came with
+static void test_credits_and_fees() {
+    Account_Book book;
+    book.open<Savings_Account>("Larry", 2000.0, 5.0);
+    book.open<Checking_Account>("Curly", 100.0);
+    book.open<Trust_Account>("Moe", 10000.0, 3.0);
+    Ledger ledger;
+    for (Ledger_Time t = 1; t <= 5; ++t) {
+        ledger.advance_to(t);
+        batch_deposit(book, 6000.0, &ledger);
+        batch_withdraw(book, 2500.0, &ledger);
+    }
+    check_replay(book, ledger, "credits and fees");
+    
+    // Declined withdrawals leave no entries
+    std::size_t entries = ledger.size();
+    ledger.advance_to(6);
+    batch_withdraw(book, 1e9, &ledger);
+    check(ledger.size() == entries, "declined withdrawals");
+    check_replay(book, ledger, "declined withdrawals");
+}
+
+// Accounts are known by their place in the book, so the ledger still finds them after the
+// book's vector has moved them
+static void test_reallocation() {
+    Account_Book book;
+    book.open<Checking_Account>("Curly", 100.0);
+    Ledger ledger;
+    batch_deposit(book, 10.0, &ledger);
+    for (int i = 0; i < 1000; ++i)
+        book.open<Savings_Account>("Larry", 100.0, 1.0);
+    ledger.advance_to(1);
+    batch_deposit(book, 10.0, &ledger);
+    check(ledger.account_count() == book.size(), "one ledger account per book account");
+    check_replay(book, ledger, "after reallocation");
+}
+
+// Failures are counted by reason, and balance_change includes interest, bonuses and fees
+static void test_batch_result() {
+    Account_Book book;
+    book.open<Checking_Account>("Curly", 100.0);
+    book.open<Savings_Account>("Larry", 1000.0, 10.0);
+    book.open<Trust_Account>("Moe", 10000.0);
+    book.open<Savings_Account>("Shemp", 5.0);
+    
+    Batch_Result result = batch_withdraw(book, 50.0);
+    check(result.succeeded == std::vector<bool>{true, true, true, false}, "withdrawal succeeded bits");
+    check(result.succeeded_count == 3 && result.declined == 0 && result.insufficient_funds == 1, "withdrawal counts");
+    check(result.failures.size() == 1 && result.failures[0].index == 3 
+          && result.failures[0].status == Account_Status::insufficient_funds, "withdrawal failures");
+    check(result.requested == Money{150.0} && result.balance_change == Money{-151.5}, "withdrawal amounts with the checking fee");
+    
+    result = batch_withdraw(book, 2500.0);
+    check(result.succeeded_count == 0 && result.declined == 1 && result.insufficient_funds == 3, "declined and insufficient");
+    check(result.failures.size() == 4 && result.failures[2].status == Account_Status::declined, "trust withdrawal over 20% declined");
+    check(result.requested == Money{} && result.balance_change == Money{}, "failed withdrawals change nothing");
+    
+    result = batch_deposit(book, 6000.0);
+    check(result.succeeded_count == 4 && result.failures.empty(), "deposit counts");
+    check(result.requested == Money{24000.0} && result.balance_change == Money{24650.0}, "deposit amounts with interest and bonus");
+    
+    result = batch_deposit(book, -1.0);
+    check(result.succeeded_count == 0 && result.declined == 4 && result.insufficient_funds == 0, "negative deposits declined");
+}
+
+// Names with commas or quotes are written in quotes, with the quotes doubled
+static void test_csv_quoting() {
+    Account_Book book;
+    book.open<Checking_Account>("Curly, \"Jr\"", 100.0);
+    book.open<Savings_Account>("Larry", 5.0);
+    std::ostringstream text;
+    {
+        Print_Buffer out {text};
+        Csv_Audit_Sink csv {out};
+        csv.write_header();
+        batch_withdraw(book, 10.0, &csv);
+        batch_deposit(book, 1.0, &csv);
+    }
+    check(text.str() == "operation,index,name,amount,status,balance_before,balance_after\n"
+                        "withdraw,0,\"Curly, \"\"Jr\"\"\",10.00,ok,100.00,88.50\n"
+                        "withdraw,1,Larry,10.00,insufficient funds,5.00,5.00\n"
+                        "deposit,0,\"Curly, \"\"Jr\"\"\",1.00,ok,88.50,89.50\n"
+                        "deposit,1,Larry,1.00,ok,5.00,6.00\n", "CSV quoting");
+}
+
+// A leg that fails puts back every account the earlier legs changed, Trust withdrawal counts too
+static void test_transaction_rollback() {
+    Trust_Account moe {"Moe", 10000.0};
+    Savings_Account larry {"Larry", 1000.0, 10.0};
+    Checking_Account curly {"Curly", 100.0};
+    
+    Transaction t;
+    t.transfer(moe, larry, 1000.0).transfer(larry, curly, 500.0).transfer(moe, curly, 500.0);
+    t.transfer(curly, larry, 5000.0);
+    check(t.size() == 4 && !t.commit(), "transaction with a failing last leg");
+    check(moe.get_balance() == Money{10000.0} && larry.get_balance() == Money{1000.0} && curly.get_balance() == Money{100.0},
+          "every balance put back");
+    check(moe.get_num_withdrawals() == 0, "trust withdrawal count put back");
+    
+    // The third withdrawal from moe goes over the trust limit
+    t.clear();
+    t.transfer(moe, curly, 100.0).transfer(moe, curly, 100.0).transfer(larry, curly, 10.0).transfer(moe, curly, 100.0);
+    t.transfer(moe, curly, 100.0);
+    check(!t.commit(), "transaction over the trust withdrawal limit");
+    check(moe.get_num_withdrawals() == 0 && moe.get_balance() == Money{10000.0} && curly.get_balance() == Money{100.0}, 
+          "limit failure puts every leg back");
+    
+    t.clear();
+    t.transfer(moe, larry, 1000.0).transfer(larry, curly, 500.0);
+    check(t.commit(), "transaction that goes through");
+    check(moe.get_balance() == Money{9000.0} && larry.get_balance() == Money{1000.0 + 1100.0 - 500.0} 
+          && curly.get_balance() == Money{600.0} && moe.get_num_withdrawals() == 1, "every leg applied");
+}
+
+// A transfer from an account to itself pays its fees and earns its interest like any other
+static void test_self_transfer() {
+    Checking_Account curly {"Curly", 100.0};
+    check(transfer(curly, curly, 50.0) && curly.get_balance() == Money{98.5}, "self-transfer pays the checking fee");
+    check(!transfer(curly, curly, 100.0) && curly.get_balance() == Money{98.5}, "self-transfer the balance can't cover");
+    
+    Savings_Account larry {"Larry", 1000.0, 10.0};
+    check(transfer(larry, larry, 100.0) && larry.get_balance() == Money{1010.0}, "self-transfer earns savings interest");
+    
+    Trust_Account moe {"Moe", 1000.0};
+    for (int i = 0; i < 3; ++i)
+        check(transfer(moe, moe, 10.0), "self-transfer within the trust limit");
+    check(moe.get_num_withdrawals() == 3 && moe.get_balance() == Money{1000.0}, "trust self-transfers counted");
+    check(!transfer(moe, moe, 10.0) && moe.get_num_withdrawals() == 3, "self-transfer over the trust limit");
+}
+
+// Runs f(i) on thread_count threads at once, i being the thread's number
+template <typename Func>
+static void run_threads(int thread_count, Func f) {
+    std::atomic<bool> go {false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; ++i)
+        threads.emplace_back([&go, &f, i]() {
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            f(i);
+        });
+    go.store(true, std::memory_order_release);
+    for (auto &t: threads)
+        t.join();
+}
+
+// Withdrawals racing on one Trust account can't take more than its 3, and every one that
+// goes through takes exactly its amount
+static void test_concurrent_withdrawals() {
+    constexpr int thread_count = 8;
+    Trust_Account moe {"Moe", 10000.0, 0.0};
+    moe.enable_concurrent_updates();
+    std::atomic<int> succeeded {0};
+    run_threads(thread_count, [&](int) {
+        if (moe.try_withdraw(100.0) == Account_Status::ok)
+            succeeded.fetch_add(1, std::memory_order_relaxed);
+    });
+    check(succeeded.load() == 3, "exactly 3 concurrent Trust withdrawals succeed");
+    check(moe.get_num_withdrawals() == 3, "concurrent Trust withdrawals counted");
+    check(moe.get_balance() == Money{9700.0}, "balance conserved by concurrent withdrawals");
+}
+
+// No deposit is lost when many threads deposit to one account at once
+static void test_concurrent_deposits() {
+    constexpr int thread_count = 8;
+    constexpr int deposits = 2000;
+    Savings_Account larry {"Larry", 1000.0, 0.0};
+    larry.enable_concurrent_updates();
+    std::atomic<int> succeeded {0};
+    run_threads(thread_count, [&](int) {
+        for (int i = 0; i < deposits; ++i)
+            if (larry.try_deposit(Money::from_cents(1)) == Account_Status::ok)
+                succeeded.fetch_add(1, std::memory_order_relaxed);
+    });
+    check(succeeded.load() == thread_count * deposits, "every concurrent deposit succeeds");
+    check(larry.get_balance() == Money{1000.0} + Money::from_cents(thread_count * deposits), "concurrent deposits sum");
+}
+
+using std::chrono::hours;
+using std::chrono::minutes;
+using std::chrono::nanoseconds;
+using Time = Withdrawal_Window::Clock::time_point;
+
+// A burst of up to the limit goes through at once, then one more withdrawal comes back every
+// period / limit - 2 a day is one every 12 hours
+static void test_withdrawal_limit_burst() {
+    Trust_Account moe {"Moe", 10000.0, 0.0};
+    moe.set_withdrawal_limit(2, hours{24});
+    Time t0 {hours{1000}};
+    check(moe.try_withdraw_at(100.0, t0) == Account_Status::ok, "first withdrawal of the burst");
+    check(moe.try_withdraw_at(100.0, t0 + minutes{1}) == Account_Status::ok, "second withdrawal of the burst");
+    check(moe.try_withdraw_at(100.0, t0 + minutes{2}) == Account_Status::declined, "burst exhausted");
+    check(moe.try_withdraw_at(100.0, t0 + hours{12} - nanoseconds{1}) == Account_Status::declined, "nothing back before the interval");
+    check(moe.try_withdraw_at(100.0, t0 + hours{12}) == Account_Status::ok, "one back after the interval");
+    check(moe.get_num_withdrawals() == 3, "declined withdrawals aren't counted");
+    check(moe.get_balance() == Money{9700.0}, "declined withdrawals take nothing");
+}
+
+// A withdrawal declined after it reserved its place in the limit - here for being over 20% of
+// the balance - gives the place back
+static void test_withdrawal_limit_give_back() {
+    Trust_Account moe {"Moe", 10000.0, 0.0};
+    moe.set_withdrawal_limit(1, hours{24});
+    Time t0 {hours{1000}};
+    check(moe.try_withdraw_at(5000.0, t0) == Account_Status::declined, "withdrawal over 20% declined");
+    check(moe.try_withdraw_at(100.0, t0) == Account_Status::ok, "declined withdrawal gave its place back");
+    check(moe.try_withdraw_at(100.0, t0 + minutes{1}) == Account_Status::declined, "limit of 1 reached");
+}
+
+// A short period still limits, and a limit without a period is refused
+static void test_withdrawal_limit_setting() {
+    Withdrawal_Window window;
+    window.set_limit(10, nanoseconds{3});
+    check(window.limited(), "period shorter than limit nanoseconds still limits");
+    int taken {0};
+    for (int i = 0; i < 10; ++i)
+        taken += window.take(1000, false);
+    check(taken > 0 && taken <= 3, "short period allows at most a period's worth at once");
+    
+    bool thrown {false};
+    try {
+        window.set_limit(1, nanoseconds{0});
+    }
+    catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    check(thrown, "limit with a zero period throws std::invalid_argument");
+    window.set_limit(0, nanoseconds{0});
+    check(!window.limited(), "limit of 0 removes it");
+}
+
+// A transaction that fails on a later leg puts the Trust account's place in the limit back
+static void test_withdrawal_limit_transaction() {
+    Trust_Account moe {"Moe", 10000.0, 0.0};
+    Checking_Account curly {"Curly", 100.0};
+    Savings_Account larry {"Larry", 10.0, 0.0};
+    moe.set_withdrawal_limit(1, hours{24});
+    Transaction transaction;
+    transaction.transfer(moe, curly, 100.0).transfer(larry, curly, 100.0);
+    check(!transaction.commit(), "transaction with a failing leg");
+    check(moe.get_num_withdrawals() == 0 && moe.get_balance() == Money{10000.0}, "Trust leg rolled back");
+    check(moe.try_withdraw(100.0) == Account_Status::ok, "rolled back withdrawal gave its place back");
+    check(moe.try_withdraw(100.0) == Account_Status::declined, "limit still applies after the rollback");
+}
+
+// The batch paths honour the same limit as try_withdraw
+static void test_withdrawal_limit_batches() {
+    Trust_Account moe {"Moe", 10000.0, 0.0};
+    moe.set_withdrawal_limit(2, hours{24});
+    
+    Account_Store store;
+    store.add(moe);
+    check(store.withdraw_all(100.0) == 1 && store.withdraw_all(100.0) == 1, "Account_Store withdrawals within the limit");
+    check(store.withdraw_all(100.0) == 0, "Account_Store withdrawal over the limit");
+    check(store.get_trust()[0].get_num_withdrawals() == 2, "Account_Store counts only withdrawals that went through");
+    
+    Account_Table table;
+    Account_Id copied = table.add(moe);
+    Account_Id opened = table.open(Account_Kind::trust, "Larry", 10000.0);
+    table.set_withdrawal_limit(opened, 2, hours{24});
+    check(table.withdraw_all(100.0) == 2 && table.withdraw_all(100.0) == 2, "Account_Table withdrawals within the limit");
+    check(table.withdraw_all(100.0) == 0, "Account_Table withdrawal over the limit");
+    check(table.try_withdraw(copied, 100.0) == Account_Status::declined, "Account_Table single withdrawal over the limit");
+    check(table.get_num_withdrawals(copied) == 2 && table.get_num_withdrawals(opened) == 2, "Account_Table counts only withdrawals that went through");
+}
+
+int main() {
+    test_money_rounding();
+    test_money_to_chars();
+    test_money_overflow();
+    test_first_operation();
+    test_credits_and_fees();
+    test_reallocation();
+    test_batch_result();
+    test_csv_quoting();
+    test_transaction_rollback();
+    test_self_transfer();
+    test_concurrent_withdrawals();
+    test_concurrent_deposits();
+    test_withdrawal_limit_burst();
+    test_withdrawal_limit_give_back();
+    test_withdrawal_limit_setting();
+    test_withdrawal_limit_transaction();
+    test_withdrawal_limit_batches();
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}
@@ -1,31 +1,81 @@
 #include "Account.h"
 
-Account::Account(std::string name, double balance) 
-    : name{name}, balance{balance} {
-        if (balance < 0.0)
+Account::Account(std::string name, Money balance) 
+    : name{name}, balance{balance}, concurrent{false} {
+        if (balance < Money{})
             throw IllegalBalanceException();
 }
 
-bool Account::deposit(double amount) {
-    if (amount < 0) 
-        return false;
-    else {
-        balance += amount;
-        return true;
-    }
+const std::string &Account::get_name() const {
+    return name;
+}
+
+// Updates from then on use atomic operations on the balance
+Account &Account::enable_concurrent_updates() {
+    concurrent = true;
+    return *this;
+}
+
+Money Account::get_balance() const {
+    if (!concurrent)
+        return balance;
+    return std::atomic_ref<Money>{const_cast<Money &>(balance)}.load(std::memory_order_acquire);
 }
 
-bool Account::withdraw(double amount) {
-    if (balance-amount >=0) {
-        balance-=amount;
+Account_Status Account::try_deposit(Money amount) {
+    if (amount < Money{}) 
+        return Account_Status::declined;
+    change_balance([amount](Money current, Money &next) {
+        next = current + amount;
         return true;
-    } else {
+    });
+    return Account_Status::ok;
+}
+
+Account_Status Account::try_withdraw(Money amount) {
+    bool withdrew = change_balance([amount](Money current, Money &next) {
+        next = current - amount;
+        return next >= Money{};
+    });
+    return withdrew ? Account_Status::ok : Account_Status::insufficient_funds;
+}
+
+bool Account::deposit(Money amount) {
+    return try_deposit(amount) == Account_Status::ok;
+}
+
+bool Account::withdraw(Money amount) {
+    Account_Status status = try_withdraw(amount);
+    if (status == Account_Status::insufficient_funds)
         throw InsufficientFundsException{};
+    return status == Account_Status::ok;
+}
+
+const char *to_string(Account_Status status) {
+    switch (status) {
+        case Account_Status::ok: return "ok";
+        case Account_Status::declined: return "declined";
+        case Account_Status::insufficient_funds: return "insufficient funds";
+        case Account_Status::illegal_balance: return "illegal balance";
     }
+    return "unknown";
+}
+
+Account_State Account::save_state() const {
+    return Account_State {get_balance(), 0};
+}
+
+void Account::restore_state(const Account_State &state) {
+    change_balance([&state](Money, Money &next) {
+        next = state.balance;
+        return true;
+    });
 }
 
  void Account::print(std::ostream &os) const {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Account: " << name << ": " << balance << "]";
+    os << "[Account: " << name << ": " << get_balance() << "]";
+}
+
+void Account::format(Print_Buffer &out) const {
+    out << "[Account: " << name << ": " << get_balance() << "]";
 }
@@ -1,24 +1,80 @@
 // Simple Account 
 #ifndef _ACCOUNT_H_
 #define _ACCOUNT_H_
+#include <atomic>         // std::atomic_ref - C++20
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include "I_Printable.h"
+#include "Print_Buffer.h"
+#include "Money.h"
+#include "Account_Result.h"
 #include "IllegalBalanceException.h"
 #include "InsufficientFundsException.h"
 
+// What a transaction saves before it changes an account, to put back if the transaction fails
+struct Account_State {
+    Money balance;
+    int num_withdrawals;
+    std::int64_t withdrawal_window {0};
+};
+
 class Account : public I_Printable {
 private:   
     static constexpr const char *def_name = "Unnamed Account";
-    static constexpr double def_balance = 0.0;
+    static constexpr Money def_balance {};
 protected:
     std::string name;
-    double balance;
+    Money balance;
+    bool concurrent;            // balance is updated with atomic operations
+    
+    // Set the balance to the one change(current, next) computes from the current balance,
+    // unless it returns false. With concurrent updates enabled this is a lock-free CAS loop,
+    // so change may be called more than once and must only depend on current.
+    template <typename Change>
+    bool change_balance(Change change);
 public:
-    Account(std::string name = def_name, double balance = def_balance);
-    virtual bool deposit(double amount) = 0;
-    virtual bool withdraw(double amount) = 0;
+    Account(std::string name = def_name, Money balance = def_balance);
+    
+    // Lets many threads deposit to and withdraw from this account at once, without a mutex.
+    // Copy, display or batch-process the account only while no updates are running.
+    Account &enable_concurrent_updates();
+    Money get_balance() const;
+    const std::string &get_name() const;
+    
+    // Non-throwing deposit and withdraw - each account type's rules live in these
+    virtual Account_Status try_deposit(Money amount) = 0;
+    virtual Account_Status try_withdraw(Money amount) = 0;
+    
+    // Throwing versions - false if declined, InsufficientFundsException if the balance can't cover it
+    bool deposit(Money amount);
+    bool withdraw(Money amount);
+    
     virtual void print(std::ostream &os) const override;
+    virtual void format(Print_Buffer &out) const override;
+    
+    virtual Account_State save_state() const;
+    virtual void restore_state(const Account_State &state);
+    
     virtual ~Account() = default;
 };
+
+template <typename Change>
+bool Account::change_balance(Change change) {
+    Money next;
+    if (!concurrent) {
+        if (!change(balance, next))
+            return false;
+        balance = next;
+        return true;
+    }
+    std::atomic_ref<Money> shared {balance};
+    Money current = shared.load(std::memory_order_relaxed);
+    do {
+        if (!change(current, next))
+            return false;
+    } while (!shared.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return true;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <type_traits>
+#include "Account_Book.h"
+
+void Account_Book::reserve(std::size_t count) {
+    accounts.reserve(count);
+}
+
+std::size_t Account_Book::size() const {
+    return accounts.size();
+}
+
+Account &Account_Book::operator[](std::size_t index) {
+    return std::visit([](auto &acc) -> Account & { return acc; }, accounts[index]);
+}
+
+const Account &Account_Book::operator[](std::size_t index) const {
+    return std::visit([](const auto &acc) -> const Account & { return acc; }, accounts[index]);
+}
+
+// The batch operations name the concrete type in each call (acc.Type::try_deposit) so it is
+// bound statically and can be inlined, even for Savings_Account which isn't final.
+
+// Deposit amount to every account
+std::size_t Account_Book::deposit_all(Money amount) {
+    std::size_t done {0};
+    for_each([&](auto &acc) {
+        using Type = std::decay_t<decltype(acc)>;
+        if (acc.Type::try_deposit(amount) == Account_Status::ok)
+            ++done;
+    });
+    return done;
+}
+
+// Withdraw amount from every account
+std::size_t Account_Book::withdraw_all(Money amount) {
+    std::size_t done {0};
+    for_each([&](auto &acc) {
+        using Type = std::decay_t<decltype(acc)>;
+        if (acc.Type::try_withdraw(amount) == Account_Status::ok)
+            ++done;
+    });
+    return done;
+}
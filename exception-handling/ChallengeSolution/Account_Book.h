@@ -0,0 +1,62 @@
+#ifndef _ACCOUNT_BOOK_H_
+#define _ACCOUNT_BOOK_H_
+#include <cstddef>
+#include <utility>
+#include <variant>      // C++17
+#include <vector>
+#include "Account.h"
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+
+// Heterogeneous account container
+// Holds any mix of account types by value, each one stored in place in a std::variant
+// inside a single vector - no new per account and no std::vector<Account*> to clean up.
+// for_each hands every account to the function as its concrete type, so batch operations
+// are dispatched on the variant's index rather than through the vtable.
+class Account_Book {
+public:
+    using Entry = std::variant<Savings_Account, Checking_Account, Trust_Account>;
+private:
+    std::vector<Entry> accounts;
+public:
+    // Construct an account of type Account_Type in the book, e.g. book.open<Trust_Account>("Moe", 5000.0, 3.0)
+    template <typename Account_Type, typename... Args>
+    Account_Type &open(Args &&... args);
+    
+    void reserve(std::size_t count);
+    std::size_t size() const;
+    
+    Account &operator[](std::size_t index);
+    const Account &operator[](std::size_t index) const;
+    
+    // Call f(acc) for every account, acc being a reference to its concrete type
+    template <typename Func>
+    void for_each(Func f);
+    template <typename Func>
+    void for_each(Func f) const;
+    
+    // Batch operations - return how many accounts they succeeded on
+    std::size_t deposit_all(Money amount);
+    std::size_t withdraw_all(Money amount);
+};
+
+template <typename Account_Type, typename... Args>
+Account_Type &Account_Book::open(Args &&... args) {
+    Entry &entry = accounts.emplace_back(std::in_place_type<Account_Type>, std::forward<Args>(args)...);
+    return std::get<Account_Type>(entry);
+}
+
+template <typename Func>
+void Account_Book::for_each(Func f) {
+    for (auto &entry: accounts)
+        std::visit(f, entry);
+}
+
+template <typename Func>
+void Account_Book::for_each(Func f) const {
+    for (const auto &entry: accounts)
+        std::visit(f, entry);
+}
+
+#endif // _ACCOUNT_BOOK_H_
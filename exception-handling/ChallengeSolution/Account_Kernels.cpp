@@ -0,0 +1,56 @@
+#include "Account_Kernels.h"
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+
+std::size_t deposit_savings(Field_Span<Money> balances, Field_Span<const double> int_rates, Money amount) {
+    std::size_t done {0};
+    for (std::size_t i = 0; i < balances.size(); ++i) {
+        Money credited = Savings_Account::with_interest(amount, int_rates[i]);
+        bool ok = credited >= Money{};
+        balances[i] += ok ? credited : Money{};
+        done += ok;
+    }
+    return done;
+}
+
+std::size_t deposit_checking(Field_Span<Money> balances, Money amount) {
+    if (amount < Money{})
+        return 0;
+    for (std::size_t i = 0; i < balances.size(); ++i)
+        balances[i] += amount;
+    return balances.size();
+}
+
+std::size_t deposit_trust(Field_Span<Money> balances, Field_Span<const double> int_rates, Money amount) {
+    return deposit_savings(balances, int_rates, Trust_Account::with_bonus(amount));
+}
+
+std::size_t withdraw_savings(Field_Span<Money> balances, Money amount) {
+    std::size_t done {0};
+    for (std::size_t i = 0; i < balances.size(); ++i) {
+        bool ok = balances[i] - amount >= Money{};
+        balances[i] -= ok ? amount : Money{};
+        done += ok;
+    }
+    return done;
+}
+
+std::size_t withdraw_checking(Field_Span<Money> balances, Money amount) {
+    return withdraw_savings(balances, Checking_Account::with_fee(amount));
+}
+
+std::size_t withdraw_trust(Field_Span<Money> balances, Field_Span<int> num_withdrawals,
+                           Field_Span<Withdrawal_Window> windows, Money amount, std::int64_t now) {
+    std::size_t done {0};
+    for (std::size_t i = 0; i < balances.size(); ++i) {
+        Money &balance = balances[i];
+        bool ok = Trust_Account::withdrawal_allowed(amount, balance, num_withdrawals[i])
+                  && balance - amount >= Money{};
+        ok = windows[i].take_if(ok, now);
+        balance -= ok ? amount : Money{};
+        num_withdrawals[i] += ok;
+        done += ok;
+    }
+    return done;
+}
@@ -0,0 +1,66 @@
+#ifndef _ACCOUNT_KERNELS_H_
+#define _ACCOUNT_KERNELS_H_
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "Money.h"
+#include "Withdrawal_Window.h"
+
+// Batch kernels, one per concrete account type
+//
+// Each applies the same rules as the type's deposit/withdraw, but written as a loop over one
+// type with no virtual calls and no branch on whether an account succeeds, so the rules inline.
+// The overflow checks in Money's arithmetic keep the loops from vectorizing.
+// They work on spans of the fields they need, so Account_Store runs them over its vectors of
+// account objects and Account_Table over its dense per-field arrays. Every span passed to one
+// call must have the same size. Each returns how many accounts it succeeded on.
+
+// One field of each of a run of values - a plain array, or a member of each object in an array
+// of objects, stride bytes apart
+template <typename T>
+class Field_Span {
+private:
+    using Byte = std::conditional_t<std::is_const_v<T>, const unsigned char, unsigned char>;
+
+    T *first;
+    std::size_t count;
+    std::size_t stride;
+public:
+    Field_Span(T *first, std::size_t count, std::size_t stride = sizeof(T))
+        : first {first}, count {count}, stride {stride} {}
+    Field_Span(std::vector<std::remove_const_t<T>> &values)
+        : Field_Span {values.data(), values.size()} {}
+
+    operator Field_Span<const T>() const { return {first, count, stride}; }
+
+    std::size_t size() const { return count; }
+    T &operator[](std::size_t i) const { return *reinterpret_cast<T *>(reinterpret_cast<Byte *>(first) + i * stride); }
+};
+
+// The span of one member of each account in accounts, e.g. field_of(savings, &Savings_Account::balance)
+template <typename Account_Type, typename Base, typename T>
+Field_Span<T> field_of(std::vector<Account_Type> &accounts, T Base::*member) {
+    if (accounts.empty())
+        return {nullptr, 0};
+    return {&(accounts.front().*member), accounts.size(), sizeof(Account_Type)};
+}
+
+// Savings: the deposit is credited with interest
+std::size_t deposit_savings(Field_Span<Money> balances, Field_Span<const double> int_rates, Money amount);
+// Checking: plain deposit
+std::size_t deposit_checking(Field_Span<Money> balances, Money amount);
+// Trust: bonus for large deposits, then interest
+std::size_t deposit_trust(Field_Span<Money> balances, Field_Span<const double> int_rates, Money amount);
+
+// Savings: plain withdrawal
+std::size_t withdraw_savings(Field_Span<Money> balances, Money amount);
+// Checking: every withdrawal pays the per check fee
+std::size_t withdraw_checking(Field_Span<Money> balances, Money amount);
+// Trust: at most 3 withdrawals of up to 20% of the balance each, within each account's
+// withdrawal rate limit. Only withdrawals that go through count towards the limits, and the
+// whole batch is timed at now.
+std::size_t withdraw_trust(Field_Span<Money> balances, Field_Span<int> num_withdrawals,
+                           Field_Span<Withdrawal_Window> windows, Money amount, std::int64_t now);
+
+#endif // _ACCOUNT_KERNELS_H_
@@ -0,0 +1,50 @@
+#ifndef _ACCOUNT_RESULT_H_
+#define _ACCOUNT_RESULT_H_
+#include <string>
+#include <utility>
+#include <variant>
+#include "Money.h"
+
+// Outcome of an account operation, reported without throwing
+enum class Account_Status {
+    ok,
+    declined,               // refused by the account's rules, e.g. a negative deposit or a Trust limit
+    insufficient_funds,     // the balance can't cover the withdrawal
+    illegal_balance         // an account can't be opened with a negative balance
+};
+
+const char *to_string(Account_Status status);
+
+// Either a value or the Account_Status saying why there isn't one - like std::expected (C++23)
+template <typename T>
+class Account_Result {
+private:
+    std::variant<T, Account_Status> result;
+public:
+    Account_Result(T value) : result{std::in_place_index<0>, std::move(value)} {}
+    Account_Result(Account_Status status) : result{std::in_place_index<1>, status} {}
+    
+    bool has_value() const { return result.index() == 0; }
+    explicit operator bool() const { return has_value(); }
+    
+    T &value() & { return std::get<0>(result); }
+    const T &value() const & { return std::get<0>(result); }
+    T &&value() && { return std::get<0>(std::move(result)); }
+    T &operator*() & { return value(); }
+    const T &operator*() const & { return value(); }
+    T *operator->() { return &value(); }
+    const T *operator->() const { return &value(); }
+    
+    Account_Status status() const { return has_value() ? Account_Status::ok : std::get<1>(result); }
+};
+
+// Opens an account of type Account_Type without throwing for a negative opening balance,
+// e.g. make_account<Savings_Account>("Larry", -2000.0, 3.0)
+template <typename Account_Type, typename... Args>
+Account_Result<Account_Type> make_account(std::string name, Money balance, Args &&... args) {
+    if (balance < Money{})
+        return Account_Status::illegal_balance;
+    return Account_Type {std::move(name), balance, std::forward<Args>(args)...};
+}
+
+#endif // _ACCOUNT_RESULT_H_
@@ -0,0 +1,52 @@
+#include <iostream>
+#include "Account_Store.h"
+#include "Account_Kernels.h"
+
+void Account_Store::add(const Savings_Account &account) {
+    savings.push_back(account);
+}
+
+void Account_Store::add(const Checking_Account &account) {
+    checking.push_back(account);
+}
+
+void Account_Store::add(const Trust_Account &account) {
+    trust.push_back(account);
+}
+
+std::size_t Account_Store::size() const {
+    return savings.size() + checking.size() + trust.size();
+}
+
+const std::vector<Savings_Account> &Account_Store::get_savings() const { return savings; }
+const std::vector<Checking_Account> &Account_Store::get_checking() const { return checking; }
+const std::vector<Trust_Account> &Account_Store::get_trust() const { return trust; }
+
+// Deposit to every account - Savings, then Checking, then Trust accounts
+std::size_t Account_Store::deposit_all(Money amount) {
+    std::size_t done = deposit_savings(field_of(savings, &Savings_Account::balance), field_of(savings, &Savings_Account::int_rate), amount);
+    done += deposit_checking(field_of(checking, &Checking_Account::balance), amount);
+    return done + deposit_trust(field_of(trust, &Trust_Account::balance), field_of(trust, &Trust_Account::int_rate), amount);
+}
+
+// Withdraw from every account - Savings, then Checking, then Trust accounts
+std::size_t Account_Store::withdraw_all(Money amount) {
+    std::size_t done = withdraw_savings(field_of(savings, &Savings_Account::balance), amount);
+    done += withdraw_checking(field_of(checking, &Checking_Account::balance), amount);
+    return done + withdraw_trust(field_of(trust, &Trust_Account::balance), field_of(trust, &Trust_Account::num_withdrawals),
+                                 field_of(trust, &Trust_Account::window), amount, Withdrawal_Window::now());
+}
+
+// Displays every account, grouped by type - buffered, with one write per 64K of output
+void Account_Store::display() const {
+    Print_Buffer out {std::cout};
+    out << "\n=== Account Store ======================================\n";
+    for (const auto &acc: savings)
+        out << acc << '\n';
+    for (const auto &acc: checking)
+        out << acc << '\n';
+    for (const auto &acc: trust)
+        out << acc << '\n';
+    out.flush();
+    std::cout.flush();
+}
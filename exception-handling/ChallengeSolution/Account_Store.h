@@ -0,0 +1,42 @@
+#ifndef _ACCOUNT_STORE_H_
+#define _ACCOUNT_STORE_H_
+#include <cstddef>
+#include <vector>
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+
+// Type-segregated account store
+// Keeps each concrete account type in its own contiguous vector, so a batch operation
+// over the whole portfolio is one tight loop per type with that type's rules inlined
+// (the kernels in Account_Kernels.h), instead of a virtual deposit/withdraw call per
+// account through Account*.
+//
+// The batch operations return how many accounts they succeeded on. A withdrawal the balance
+// can't cover just leaves that account as it was. Every balance change is checked Money
+// arithmetic, though, so a credit that would overflow a balance throws MoneyOverflowException,
+// leaving the accounts before it changed and the rest as they were.
+class Account_Store {
+    friend class Interest_Engine;
+private:
+    std::vector<Savings_Account> savings;
+    std::vector<Checking_Account> checking;
+    std::vector<Trust_Account> trust;
+
+public:
+    void add(const Savings_Account &account);
+    void add(const Checking_Account &account);
+    void add(const Trust_Account &account);
+    
+    std::size_t size() const;
+    const std::vector<Savings_Account> &get_savings() const;
+    const std::vector<Checking_Account> &get_checking() const;
+    const std::vector<Trust_Account> &get_trust() const;
+    
+    std::size_t deposit_all(Money amount);             // deposit amount to every account
+    std::size_t withdraw_all(Money amount);            // withdraw amount from every account
+    
+    void display() const;
+};
+
+#endif // _ACCOUNT_STORE_H_
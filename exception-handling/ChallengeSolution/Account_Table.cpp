@@ -0,0 +1,210 @@
+#include <iostream>
+#include "Account_Table.h"
+#include "Account_Kernels.h"
+
+Account_Id Account_Table::add_info(std::string name, Account_Kind kind, std::size_t row) {
+    info.push_back(Account_Info {std::move(name), kind, static_cast<std::uint32_t>(row)});
+    return static_cast<Account_Id>(info.size() - 1);
+}
+
+// Open a new account - int_rate is ignored for Checking accounts
+Account_Id Account_Table::open(Account_Kind kind, std::string name, Money balance, double int_rate) {
+    if (balance < Money{})
+        throw IllegalBalanceException();
+    switch (kind) {
+        case Account_Kind::savings:
+            savings.balances.push_back(balance);
+            savings.int_rates.push_back(int_rate);
+            return add_info(std::move(name), kind, savings.balances.size() - 1);
+        case Account_Kind::checking:
+            checking.balances.push_back(balance);
+            return add_info(std::move(name), kind, checking.balances.size() - 1);
+        case Account_Kind::trust:
+            trust.balances.push_back(balance);
+            trust.int_rates.push_back(int_rate);
+            trust.num_withdrawals.push_back(0);
+            trust.windows.emplace_back();
+            return add_info(std::move(name), kind, trust.balances.size() - 1);
+    }
+    return add_info(std::move(name), kind, 0);
+}
+
+Account_Id Account_Table::add(const Savings_Account &account) {
+    return open(Account_Kind::savings, account.get_name(), account.get_balance(), account.get_int_rate());
+}
+
+Account_Id Account_Table::add(const Checking_Account &account) {
+    return open(Account_Kind::checking, account.get_name(), account.get_balance());
+}
+
+// Copies the account's withdrawal count and limit too
+Account_Id Account_Table::add(const Trust_Account &account) {
+    Account_Id id = open(Account_Kind::trust, account.get_name(), account.get_balance(), account.get_int_rate());
+    trust.num_withdrawals.back() = account.get_num_withdrawals();
+    trust.windows.back() = account.window;
+    return id;
+}
+
+void Account_Table::reserve(Account_Kind kind, std::size_t count) {
+    info.reserve(info.size() + count);
+    switch (kind) {
+        case Account_Kind::savings:
+            savings.balances.reserve(savings.balances.size() + count);
+            savings.int_rates.reserve(savings.int_rates.size() + count);
+            break;
+        case Account_Kind::checking:
+            checking.balances.reserve(checking.balances.size() + count);
+            break;
+        case Account_Kind::trust:
+            trust.balances.reserve(trust.balances.size() + count);
+            trust.int_rates.reserve(trust.int_rates.size() + count);
+            trust.num_withdrawals.reserve(trust.num_withdrawals.size() + count);
+            trust.windows.reserve(trust.windows.size() + count);
+            break;
+    }
+}
+
+std::size_t Account_Table::size() const {
+    return info.size();
+}
+
+Account_Kind Account_Table::get_kind(Account_Id id) const {
+    return info[id].kind;
+}
+
+const std::string &Account_Table::get_name(Account_Id id) const {
+    return info[id].name;
+}
+
+Money Account_Table::get_balance(Account_Id id) const {
+    const Account_Info &acc = info[id];
+    switch (acc.kind) {
+        case Account_Kind::savings: return savings.balances[acc.row];
+        case Account_Kind::checking: return checking.balances[acc.row];
+        case Account_Kind::trust: return trust.balances[acc.row];
+    }
+    return Money{};
+}
+
+double Account_Table::get_int_rate(Account_Id id) const {
+    const Account_Info &acc = info[id];
+    switch (acc.kind) {
+        case Account_Kind::savings: return savings.int_rates[acc.row];
+        case Account_Kind::checking: return 0;
+        case Account_Kind::trust: return trust.int_rates[acc.row];
+    }
+    return 0;
+}
+
+int Account_Table::get_num_withdrawals(Account_Id id) const {
+    const Account_Info &acc = info[id];
+    return (acc.kind == Account_Kind::trust) ? trust.num_withdrawals[acc.row] : 0;
+}
+
+void Account_Table::set_withdrawal_limit(Account_Id id, int limit, std::chrono::nanoseconds period) {
+    const Account_Info &acc = info[id];
+    if (acc.kind == Account_Kind::trust)
+        trust.windows[acc.row].set_limit(limit, period);
+}
+
+// Single-account operations - the same rules as each type's try_deposit/try_withdraw
+
+Account_Status Account_Table::try_deposit(Account_Id id, Money amount) {
+    const Account_Info &acc = info[id];
+    Money credited;
+    Money *balance;
+    switch (acc.kind) {
+        case Account_Kind::savings:
+            credited = Savings_Account::with_interest(amount, savings.int_rates[acc.row]);
+            balance = &savings.balances[acc.row];
+            break;
+        case Account_Kind::checking:
+            credited = amount;
+            balance = &checking.balances[acc.row];
+            break;
+        case Account_Kind::trust:
+        default:
+            credited = Savings_Account::with_interest(Trust_Account::with_bonus(amount), trust.int_rates[acc.row]);
+            balance = &trust.balances[acc.row];
+            break;
+    }
+    if (credited < Money{})
+        return Account_Status::declined;
+    *balance += credited;
+    return Account_Status::ok;
+}
+
+Account_Status Account_Table::try_withdraw(Account_Id id, Money amount) {
+    const Account_Info &acc = info[id];
+    switch (acc.kind) {
+        case Account_Kind::savings: {
+            Money &balance = savings.balances[acc.row];
+            if (balance - amount < Money{})
+                return Account_Status::insufficient_funds;
+            balance -= amount;
+            return Account_Status::ok;
+        }
+        case Account_Kind::checking: {
+            Money &balance = checking.balances[acc.row];
+            Money with_fee = Checking_Account::with_fee(amount);
+            if (balance - with_fee < Money{})
+                return Account_Status::insufficient_funds;
+            balance -= with_fee;
+            return Account_Status::ok;
+        }
+        case Account_Kind::trust:
+        default: {
+            Money &balance = trust.balances[acc.row];
+            int &num_withdrawals = trust.num_withdrawals[acc.row];
+            bool ok = Trust_Account::withdrawal_allowed(amount, balance, num_withdrawals) && balance - amount >= Money{};
+            if (!trust.windows[acc.row].take_if(ok, Withdrawal_Window::now()))
+                return Account_Status::declined;
+            balance -= amount;
+            ++num_withdrawals;
+            return Account_Status::ok;
+        }
+    }
+}
+
+// Batch operations
+// The same kernels as Account_Store's, over the hot arrays only
+
+std::size_t Account_Table::deposit_all(Money amount) {
+    std::size_t done = deposit_savings(savings.balances, savings.int_rates, amount);
+    done += deposit_checking(checking.balances, amount);
+    return done + deposit_trust(trust.balances, trust.int_rates, amount);
+}
+
+std::size_t Account_Table::withdraw_all(Money amount) {
+    std::size_t done = withdraw_savings(savings.balances, amount);
+    done += withdraw_checking(checking.balances, amount);
+    return done + withdraw_trust(trust.balances, trust.num_withdrawals, trust.windows, amount, Withdrawal_Window::now());
+}
+
+void Account_Table::format(Account_Id id, Print_Buffer &out) const {
+    const Account_Info &acc = info[id];
+    switch (acc.kind) {
+        case Account_Kind::savings:
+            (out << "[Savings_Account: " << acc.name << ": " << savings.balances[acc.row] << ", ").fixed(savings.int_rates[acc.row]) << "]";
+            break;
+        case Account_Kind::checking:
+            out << "[Checking_Account: " << acc.name << ": " << checking.balances[acc.row] << "]";
+            break;
+        case Account_Kind::trust:
+            (out << "[Trust Account: " << acc.name << ": " << trust.balances[acc.row] << ", ").fixed(trust.int_rates[acc.row])
+                << "%, withdrawals: " << trust.num_withdrawals[acc.row] << "]";
+            break;
+    }
+}
+
+// Displays every account in id order
+void Account_Table::display() const {
+    Print_Buffer out {std::cout};
+    out << "\n=== Account Table ======================================\n";
+    for (Account_Id id = 0; id < info.size(); ++id) {
+        format(id, out);
+        out << '\n';
+    }
+    out.flush();
+    std::cout.flush();
+}
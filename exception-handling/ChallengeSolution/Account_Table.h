@@ -0,0 +1,87 @@
+#ifndef _ACCOUNT_TABLE_H_
+#define _ACCOUNT_TABLE_H_
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+#include "Withdrawal_Window.h"
+
+using Account_Id = std::uint32_t;
+
+enum class Account_Kind : std::uint8_t {savings, checking, trust};
+
+// Hot/cold split account table
+//
+// An account object is mostly things a deposit never looks at: the vptr, the 32-byte
+// std::string name (and its heap block for long names) and the concurrency flag, so a batch
+// over Account_Store pulls a 64-byte cache line in for every 8-byte balance it updates.
+// Account_Table keeps the fields deposits and withdrawals use - balances, interest rates,
+// withdrawal counts and limits - in dense arrays, one per field and account type, and the
+// names in a separate cold array indexed by account id. deposit_all and withdraw_all only
+// stream through the hot arrays they need (a Checking batch reads and writes 8 bytes an account).
+//
+// Accounts are opened with the same rules as the account classes (IllegalBalanceException for
+// a negative balance) and deposits and withdrawals follow each type's rules, returning an
+// Account_Status. Ids are handed out in order from 0 and stay valid; accounts are never removed.
+// The table has no concurrent mode - update it from one thread at a time.
+class Account_Table {
+private:
+    // Hot - one array per field, indexed by the account's row within its type
+    struct Savings_Rows {
+        std::vector<Money> balances;
+        std::vector<double> int_rates;
+    };
+    struct Checking_Rows {
+        std::vector<Money> balances;
+    };
+    struct Trust_Rows {
+        std::vector<Money> balances;
+        std::vector<double> int_rates;
+        std::vector<int> num_withdrawals;
+        std::vector<Withdrawal_Window> windows;
+    };
+    Savings_Rows savings;
+    Checking_Rows checking;
+    Trust_Rows trust;
+    
+    // Cold - indexed by account id
+    struct Account_Info {
+        std::string name;
+        Account_Kind kind;
+        std::uint32_t row;
+    };
+    std::vector<Account_Info> info;
+    
+    Account_Id add_info(std::string name, Account_Kind kind, std::size_t row);
+public:
+    Account_Id open(Account_Kind kind, std::string name, Money balance = Money{}, double int_rate = 0);
+    Account_Id add(const Savings_Account &account);
+    Account_Id add(const Checking_Account &account);
+    Account_Id add(const Trust_Account &account);
+    void reserve(Account_Kind kind, std::size_t count);
+    
+    std::size_t size() const;
+    Account_Kind get_kind(Account_Id id) const;
+    const std::string &get_name(Account_Id id) const;
+    Money get_balance(Account_Id id) const;
+    double get_int_rate(Account_Id id) const;            // 0 for Checking accounts
+    int get_num_withdrawals(Account_Id id) const;        // 0 except for Trust accounts
+    
+    // Withdrawal rate limit for a Trust account - see Trust_Account::set_withdrawal_limit
+    void set_withdrawal_limit(Account_Id id, int limit, std::chrono::nanoseconds period);
+    
+    Account_Status try_deposit(Account_Id id, Money amount);
+    Account_Status try_withdraw(Account_Id id, Money amount);
+    
+    std::size_t deposit_all(Money amount);             // deposit amount to every account
+    std::size_t withdraw_all(Money amount);            // withdraw amount from every account
+    
+    void format(Account_Id id, Print_Buffer &out) const;        // as the account class prints it
+    void display() const;
+};
+
+#endif // _ACCOUNT_TABLE_H_
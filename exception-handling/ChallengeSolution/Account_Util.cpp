@@ -1,124 +1,78 @@
 #include <iostream>
+#include <type_traits>
 #include "Account_Util.h"
 
-// Displays Account objects in a vector of Account objects 
-void display(const std::vector<Account> &accounts) {
-    std::cout << "\n=== Accounts===========================================" << std::endl;
-    for (const auto &acc: accounts) 
-        std::cout << acc << std::endl;
+// Displays every account in the book - buffered, with one write per 64K of output
+void display(const Account_Book &accounts) {
+    Print_Buffer out {std::cout};
+    out << "\n=== Accounts===========================================\n";
+    accounts.for_each([&out](const auto &acc) {
+        out << acc << '\n';
+    });
+    out.flush();
+    std::cout.flush();
 }
 
-// Deposits supplied amount to each Account object in the vector
-void deposit(std::vector<Account> &accounts, double amount) {
+// Deposits supplied amount to each account in the book
+void deposit(Account_Book &accounts, Money amount) {
     std::cout << "\n=== Depositing to Accounts =================================" << std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.deposit(amount)) 
+    accounts.for_each([amount](auto &acc) {
+        if (acc.try_deposit(amount) == Account_Status::ok) 
             std::cout << "Deposited " << amount << " to " << acc << std::endl;
         else
             std::cout << "Failed Deposit of " << amount << " to " << acc << std::endl;
-    }
+    });
 }
 
-// Withdraw amount from each Account object in the vector
-void withdraw(std::vector<Account> &accounts, double amount) {
+// Withdraw supplied amount from each account in the book
+void withdraw(Account_Book &accounts, Money amount) {
     std::cout << "\n=== Withdrawing from Accounts ==============================" <<std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.withdraw(amount)) 
+    accounts.for_each([amount](auto &acc) {
+        if (acc.try_withdraw(amount) == Account_Status::ok) 
             std::cout << "Withdrew " << amount << " from " << acc << std::endl;
         else
             std::cout << "Failed Withdrawal of " << amount << " from " << acc << std::endl;
-    } 
+    });
 }
 
-// Helper functions for Savings Account class
-
-// Displays Savings Account objects in a  vector of Savings Account objects 
-void display(const std::vector<Savings_Account> &accounts) {
-    std::cout << "\n=== Savings Accounts=====================================" << std::endl;
-    for (const auto &acc: accounts) 
-        std::cout << acc << std::endl;
-}
-
-// Deposits supplied amount to each Savings Account object in the vector
-void deposit(std::vector<Savings_Account> &accounts, double amount) {
-    std::cout << "\n=== Depositing to Savings Accounts===========================" << std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.deposit(amount)) 
-            std::cout << "Deposited " << amount << " to " << acc << std::endl;
-        else
-            std::cout << "Failed Deposit of " << amount << " to " << acc << std::endl;
-    }
-}
-
-// Withdraw supplied amount from each Savings Account object in the vector
-void withdraw(std::vector<Savings_Account> &accounts, double amount) {
-    std::cout << "\n=== Withdrawing from Savings Accounts=======================" << std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.withdraw(amount)) 
-            std::cout << "Withdrew " << amount << " from " << acc << std::endl;
-        else
-            std::cout << "Failed Withdrawal of " << amount << " from " << acc << std::endl;
-    } 
-}
-
-// Helper functions for Checking Account class
-
-// Displays Checking Account objects in a  vector of Checking Account objects 
-void display(const std::vector<Checking_Account> &accounts) {
-    std::cout << "\n=== Checking Accounts=====================================" << std::endl;
-    for (const auto &acc: accounts) 
-        std::cout << acc << std::endl;
-}
-
-// Deposits supplied amount to each Checking Account object in the vector
-void deposit(std::vector<Checking_Account> &accounts, double amount) {
-    std::cout << "\n=== Depositing to Checking Accounts===========================" << std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.deposit(amount)) 
-            std::cout << "Deposited " << amount << " to " << acc << std::endl;
-        else
-            std::cout << "Failed Deposit of " << amount << " to " << acc << std::endl;
-    }
-}
-
-// Withdraw supplied amount from each Checking Account object in the vector
-void withdraw(std::vector<Checking_Account> &accounts, double amount) {
-    std::cout << "\n=== Withdrawing from Checking Accounts=======================" << std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.withdraw(amount)) 
-            std::cout << "Withdrew " << amount << " from " << acc << std::endl;
-        else
-            std::cout << "Failed Withdrawal of " << amount << " from " << acc << std::endl;
-    } 
+// Runs operation (try_deposit or try_withdraw) on every account, filling in a Batch_Result
+// instead of printing
+static Batch_Result run_batch(Account_Book &accounts, Money amount, Operation operation, Audit_Sink *audit) {
+    Batch_Result result;
+    result.succeeded.reserve(accounts.size());
+    std::size_t index {0};
+    accounts.for_each([&](auto &acc) {
+        using Type = std::decay_t<decltype(acc)>;
+        Money before = acc.get_balance();
+        Account_Status status = operation == Operation::deposit ? acc.Type::try_deposit(amount) : acc.Type::try_withdraw(amount);
+        Money after = acc.get_balance();
+        
+        bool ok = status == Account_Status::ok;
+        result.succeeded.push_back(ok);
+        if (ok) {
+            ++result.succeeded_count;
+            result.requested += amount;
+        } else {
+            result.failures.push_back(Batch_Failure {index, status});
+            if (status == Account_Status::insufficient_funds)
+                ++result.insufficient_funds;
+            else
+                ++result.declined;
+        }
+        result.balance_change += after - before;
+        if (audit)
+            audit->record(Audit_Record {operation, index, acc, amount, status, before, after});
+        ++index;
+    });
+    return result;
 }
 
-// Helper functions for Trust Account class
-
-// Displays Trust Account objects in a  vector of Trust Account objects 
-void display(const std::vector<Trust_Account> &accounts) {
-    std::cout << "\n=== Trust Accounts=====================================" << std::endl;
-    for (const auto &acc: accounts) 
-        std::cout << acc << std::endl;
+// Deposits amount to each account in the book without printing
+Batch_Result batch_deposit(Account_Book &accounts, Money amount, Audit_Sink *audit) {
+    return run_batch(accounts, amount, Operation::deposit, audit);
 }
 
-// Deposits supplied amount to each Trust Account object in the vector
-void deposit(std::vector<Trust_Account> &accounts, double amount) {
-    std::cout << "\n=== Depositing to Trust Accounts===========================" << std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.deposit(amount)) 
-            std::cout << "Deposited " << amount << " to " << acc << std::endl;
-        else
-            std::cout << "Failed Deposit of " << amount << " to " << acc << std::endl;
-    }
+// Withdraws amount from each account in the book without printing
+Batch_Result batch_withdraw(Account_Book &accounts, Money amount, Audit_Sink *audit) {
+    return run_batch(accounts, amount, Operation::withdraw, audit);
 }
-
-// Withdraw supplied amount from each Trust Account object in the vector
-void withdraw(std::vector<Trust_Account> &accounts, double amount) {
-    std::cout << "\n=== Withdrawing from Trust Accounts=======================" << std::endl;
-    for (auto &acc:accounts)  {
-        if (acc.withdraw(amount)) 
-            std::cout << "Withdrew " << amount << " from " << acc << std::endl;
-        else
-            std::cout << "Failed Withdrawal of " << amount << " from " << acc << std::endl;
-    } 
-}
\ No newline at end of file
@@ -1,31 +1,35 @@
 #ifndef _ACCOUNT_UTIL_H_
 #define _ACCOUNT_UTIL_H_
+#include <cstddef>
 #include <vector>
-#include "Account.h"
-#include "Savings_Account.h"
-#include "Checking_Account.h"
-#include "Trust_Account.h"
+#include "Account_Book.h"
+#include "Audit_Sink.h"
 
-// Utility helper functions for Account class
+// Utility helper functions for an Account_Book holding any mix of account types
 
-void display(const std::vector<Account> &accounts);
-void deposit(std::vector<Account> &accounts, double amount);
-void withdraw(std::vector<Account> &accounts, double amount);
+void display(const Account_Book &accounts);
+void deposit(Account_Book &accounts, Money amount);
+void withdraw(Account_Book &accounts, Money amount);
 
-// Utility helper functions for Savings Account class
+// Quiet batch versions - nothing is printed. The result summarizes the batch, and an
+// Audit_Sink, if given, receives a record for every account.
 
-void display(const std::vector<Savings_Account> &accounts);
-void deposit(std::vector<Savings_Account> &accounts, double amount);
-void withdraw(std::vector<Savings_Account> &accounts, double amount);
+struct Batch_Failure {
+    std::size_t index;              // position of the account in the book
+    Account_Status status;          // why it failed
+};
 
-// Utility helper functions for Checking Account class
-void display(const std::vector<Checking_Account> &accounts);
-void deposit(std::vector<Checking_Account> &accounts, double amount);
-void withdraw(std::vector<Checking_Account> &accounts, double amount);
+struct Batch_Result {
+    std::vector<bool> succeeded;            // one bit per account, in book order
+    std::size_t succeeded_count {0};
+    std::vector<Batch_Failure> failures;
+    std::size_t declined {0};                   // failures by reason
+    std::size_t insufficient_funds {0};
+    Money requested;                             // amount times the accounts it succeeded on
+    Money balance_change;                     // net change of all balances - with interest, bonuses and fees
+};
 
-// Utility helper functions for Trust Account class
-void display(const std::vector<Trust_Account> &accounts);
-void deposit(std::vector<Trust_Account> &accounts, double amount);
-void withdraw(std::vector<Trust_Account> &accounts, double amount);
+Batch_Result batch_deposit(Account_Book &accounts, Money amount, Audit_Sink *audit = nullptr);
+Batch_Result batch_withdraw(Account_Book &accounts, Money amount, Audit_Sink *audit = nullptr);
 
-#endif
\ No newline at end of file
+#endif
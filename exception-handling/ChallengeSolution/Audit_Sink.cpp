@@ -0,0 +1,39 @@
+#include "Audit_Sink.h"
+
+const char *to_string(Operation operation) {
+    switch (operation) {
+        case Operation::deposit: return "deposit";
+        case Operation::withdraw: return "withdraw";
+    }
+    return "unknown";
+}
+
+Csv_Audit_Sink::Csv_Audit_Sink(Print_Buffer &out)
+    : out{out} {
+}
+
+void Csv_Audit_Sink::write_header() {
+    out << "operation,index,name,amount,status,balance_before,balance_after\n";
+}
+
+// Names with commas, quotes or line breaks go in quotes, with any quotes doubled
+static void write_field(Print_Buffer &out, const std::string &text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        out << text;
+        return;
+    }
+    out << '"';
+    for (char c: text) {
+        if (c == '"')
+            out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+void Csv_Audit_Sink::record(const Audit_Record &record) {
+    out << to_string(record.operation) << ',' << static_cast<long long>(record.index) << ',';
+    write_field(out, record.account.get_name());
+    out << ',' << record.amount << ',' << to_string(record.status) << ','
+        << record.balance_before << ',' << record.balance_after << '\n';
+}
@@ -0,0 +1,40 @@
+#ifndef _AUDIT_SINK_H_
+#define _AUDIT_SINK_H_
+#include <cstddef>
+#include "Account.h"
+#include "Print_Buffer.h"
+
+enum class Operation {deposit, withdraw};
+
+const char *to_string(Operation operation);     // "deposit" or "withdraw", as in the CSV
+
+// One account's part in a batch operation
+struct Audit_Record {
+    Operation operation;
+    std::size_t index;               // position of the account in the batch - its Account_Book index
+    const Account &account;
+    Money amount;                    // amount asked for
+    Account_Status status;
+    Money balance_before;
+    Money balance_after;
+};
+
+// Receives an Audit_Record for every account a batch operation touches
+class Audit_Sink {
+public:
+    virtual void record(const Audit_Record &record) = 0;
+    virtual ~Audit_Sink() = default;
+};
+
+// Writes each record as a line of comma-separated values:
+//     operation,index,name,amount,status,balance_before,balance_after
+class Csv_Audit_Sink : public Audit_Sink {
+private:
+    Print_Buffer &out;
+public:
+    explicit Csv_Audit_Sink(Print_Buffer &out);
+    void write_header();
+    virtual void record(const Audit_Record &record) override;
+};
+
+#endif // _AUDIT_SINK_H_
@@ -52,7 +52,7 @@ LibPath                := $(LibraryPathSwitch).
 AR       := C:/MinGW/bin/ar.exe rcu
 CXX      := C:/MinGW/bin/g++.exe
 CC       := C:/MinGW/bin/gcc.exe
-CXXFLAGS := -std=c++14 -Wall -g -O0 -std=c++14 -Wall $(Preprocessors)
+CXXFLAGS := -std=c++20 -Wall -g -O0 -std=c++20 -Wall $(Preprocessors)
 CFLAGS   :=  -g -O0 -Wall $(Preprocessors)
 ASFLAGS  := 
 AS       := C:/MinGW/bin/as.exe
@@ -62,7 +62,7 @@ AS       := C:/MinGW/bin/as.exe
 ## User defined environment variables
 ##
 CodeLiteDir:=C:\Program Files\CodeLite
-Objects0=$(IntermediateDirectory)/main.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account_Util.cpp$(ObjectSuffix) $(IntermediateDirectory)/Checking_Account.cpp$(ObjectSuffix) $(IntermediateDirectory)/I_Printable.cpp$(ObjectSuffix) $(IntermediateDirectory)/Savings_Account.cpp$(ObjectSuffix) $(IntermediateDirectory)/Trust_Account.cpp$(ObjectSuffix) 
+Objects0=$(IntermediateDirectory)/main.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account_Util.cpp$(ObjectSuffix) $(IntermediateDirectory)/Checking_Account.cpp$(ObjectSuffix) $(IntermediateDirectory)/I_Printable.cpp$(ObjectSuffix) $(IntermediateDirectory)/Savings_Account.cpp$(ObjectSuffix) $(IntermediateDirectory)/Trust_Account.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account_Store.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account_Book.cpp$(ObjectSuffix) $(IntermediateDirectory)/Money.cpp$(ObjectSuffix) $(IntermediateDirectory)/Transaction.cpp$(ObjectSuffix) $(IntermediateDirectory)/Print_Buffer.cpp$(ObjectSuffix) $(IntermediateDirectory)/Audit_Sink.cpp$(ObjectSuffix) $(IntermediateDirectory)/Ledger.cpp$(ObjectSuffix) $(IntermediateDirectory)/Interest_Engine.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account_Table.cpp$(ObjectSuffix) $(IntermediateDirectory)/Account_Kernels.cpp$(ObjectSuffix) 
 
 
 
@@ -149,6 +149,86 @@ $(IntermediateDirectory)/Trust_Account.cpp$(DependSuffix): Trust_Account.cpp
 $(IntermediateDirectory)/Trust_Account.cpp$(PreprocessSuffix): Trust_Account.cpp
 	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Trust_Account.cpp$(PreprocessSuffix) Trust_Account.cpp
 
+$(IntermediateDirectory)/Account_Store.cpp$(ObjectSuffix): Account_Store.cpp $(IntermediateDirectory)/Account_Store.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Account_Store.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Account_Store.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Account_Store.cpp$(DependSuffix): Account_Store.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Account_Store.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Account_Store.cpp$(DependSuffix) -MM Account_Store.cpp
+
+$(IntermediateDirectory)/Account_Store.cpp$(PreprocessSuffix): Account_Store.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Account_Store.cpp$(PreprocessSuffix) Account_Store.cpp
+
+$(IntermediateDirectory)/Account_Book.cpp$(ObjectSuffix): Account_Book.cpp $(IntermediateDirectory)/Account_Book.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Account_Book.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Account_Book.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Account_Book.cpp$(DependSuffix): Account_Book.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Account_Book.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Account_Book.cpp$(DependSuffix) -MM Account_Book.cpp
+
+$(IntermediateDirectory)/Account_Book.cpp$(PreprocessSuffix): Account_Book.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Account_Book.cpp$(PreprocessSuffix) Account_Book.cpp
+
+$(IntermediateDirectory)/Money.cpp$(ObjectSuffix): Money.cpp $(IntermediateDirectory)/Money.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Money.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Money.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Money.cpp$(DependSuffix): Money.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Money.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Money.cpp$(DependSuffix) -MM Money.cpp
+
+$(IntermediateDirectory)/Money.cpp$(PreprocessSuffix): Money.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Money.cpp$(PreprocessSuffix) Money.cpp
+
+$(IntermediateDirectory)/Transaction.cpp$(ObjectSuffix): Transaction.cpp $(IntermediateDirectory)/Transaction.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Transaction.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Transaction.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Transaction.cpp$(DependSuffix): Transaction.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Transaction.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Transaction.cpp$(DependSuffix) -MM Transaction.cpp
+
+$(IntermediateDirectory)/Transaction.cpp$(PreprocessSuffix): Transaction.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Transaction.cpp$(PreprocessSuffix) Transaction.cpp
+
+$(IntermediateDirectory)/Print_Buffer.cpp$(ObjectSuffix): Print_Buffer.cpp $(IntermediateDirectory)/Print_Buffer.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Print_Buffer.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Print_Buffer.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Print_Buffer.cpp$(DependSuffix): Print_Buffer.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Print_Buffer.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Print_Buffer.cpp$(DependSuffix) -MM Print_Buffer.cpp
+
+$(IntermediateDirectory)/Print_Buffer.cpp$(PreprocessSuffix): Print_Buffer.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Print_Buffer.cpp$(PreprocessSuffix) Print_Buffer.cpp
+
+$(IntermediateDirectory)/Audit_Sink.cpp$(ObjectSuffix): Audit_Sink.cpp $(IntermediateDirectory)/Audit_Sink.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Audit_Sink.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Audit_Sink.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Audit_Sink.cpp$(DependSuffix): Audit_Sink.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Audit_Sink.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Audit_Sink.cpp$(DependSuffix) -MM Audit_Sink.cpp
+
+$(IntermediateDirectory)/Audit_Sink.cpp$(PreprocessSuffix): Audit_Sink.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Audit_Sink.cpp$(PreprocessSuffix) Audit_Sink.cpp
+
+$(IntermediateDirectory)/Ledger.cpp$(ObjectSuffix): Ledger.cpp $(IntermediateDirectory)/Ledger.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Ledger.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Ledger.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Ledger.cpp$(DependSuffix): Ledger.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Ledger.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Ledger.cpp$(DependSuffix) -MM Ledger.cpp
+
+$(IntermediateDirectory)/Ledger.cpp$(PreprocessSuffix): Ledger.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Ledger.cpp$(PreprocessSuffix) Ledger.cpp
+
+$(IntermediateDirectory)/Interest_Engine.cpp$(ObjectSuffix): Interest_Engine.cpp $(IntermediateDirectory)/Interest_Engine.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Interest_Engine.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Interest_Engine.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Interest_Engine.cpp$(DependSuffix): Interest_Engine.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Interest_Engine.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Interest_Engine.cpp$(DependSuffix) -MM Interest_Engine.cpp
+
+$(IntermediateDirectory)/Interest_Engine.cpp$(PreprocessSuffix): Interest_Engine.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Interest_Engine.cpp$(PreprocessSuffix) Interest_Engine.cpp
+
+$(IntermediateDirectory)/Account_Table.cpp$(ObjectSuffix): Account_Table.cpp $(IntermediateDirectory)/Account_Table.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Account_Table.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Account_Table.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Account_Table.cpp$(DependSuffix): Account_Table.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Account_Table.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Account_Table.cpp$(DependSuffix) -MM Account_Table.cpp
+
+$(IntermediateDirectory)/Account_Table.cpp$(PreprocessSuffix): Account_Table.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Account_Table.cpp$(PreprocessSuffix) Account_Table.cpp
+
+$(IntermediateDirectory)/Account_Kernels.cpp$(ObjectSuffix): Account_Kernels.cpp $(IntermediateDirectory)/Account_Kernels.cpp$(DependSuffix)
+	$(CXX) $(IncludePCH) $(SourceSwitch) "C:/Users/frank/Desktop/CPPExamples/Section18/ChallengeSolution/Account_Kernels.cpp" $(CXXFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/Account_Kernels.cpp$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/Account_Kernels.cpp$(DependSuffix): Account_Kernels.cpp
+	@$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/Account_Kernels.cpp$(ObjectSuffix) -MF$(IntermediateDirectory)/Account_Kernels.cpp$(DependSuffix) -MM Account_Kernels.cpp
+
+$(IntermediateDirectory)/Account_Kernels.cpp$(PreprocessSuffix): Account_Kernels.cpp
+	$(CXX) $(CXXFLAGS) $(IncludePCH) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/Account_Kernels.cpp$(PreprocessSuffix) Account_Kernels.cpp
+
 
 -include $(IntermediateDirectory)/*$(DependSuffix)
 ##
@@ -1,6 +1,6 @@
 #include "Checking_Account.h"
 
-Checking_Account::Checking_Account(std::string name, double balance)
+Checking_Account::Checking_Account(std::string name, Money balance)
     : Account{name, balance} {}
 //    try : Account {name, balance} {
 //        
@@ -10,18 +10,19 @@ Checking_Account::Checking_Account(std::string name, double balance)
 //    }
 
 
-bool Checking_Account::withdraw(double amount) {
-    amount += per_check_fee;
-    return Account::withdraw(amount);
+Account_Status Checking_Account::try_withdraw(Money amount) {
+    return Account::try_withdraw(with_fee(amount));
 }
 
-bool Checking_Account::deposit(double amount) {
-    return Account::deposit(amount);
+Account_Status Checking_Account::try_deposit(Money amount) {
+    return Account::try_deposit(amount);
 }
 
 void Checking_Account::print(std::ostream &os) const {
-    os.precision(2);
-    os << std::fixed;
-    os << "[Checking_Account: " << name << ": " << balance  << "]";
+    os << "[Checking_Account: " << name << ": " << get_balance()  << "]";
+}
+
+void Checking_Account::format(Print_Buffer &out) const {
+    out << "[Checking_Account: " << name << ": " << get_balance()  << "]";
 }
 
@@ -4,16 +4,22 @@
 #include <string>
 #include "Account.h"
 
-class Checking_Account: public Account {
+class Checking_Account final: public Account {
+    friend class Account_Store;
+    friend class Account_Table;
 private:
     static constexpr const char *def_name = "Unnamed Checking Account";
-    static constexpr double def_balance = 0.0;
-    static constexpr double per_check_fee = 1.5;
+    static constexpr Money def_balance {};
+    static constexpr Money per_check_fee = 1.5;
 public:
-    Checking_Account(std::string name = def_name, double balance = def_balance);    
-    virtual bool withdraw(double) override;
-    virtual bool deposit(double) override;
+    // Amount taken from the balance for a withdrawal, fee included
+    static Money with_fee(Money amount) { return amount + per_check_fee; }
+    
+    Checking_Account(std::string name = def_name, Money balance = def_balance);    
+    virtual Account_Status try_withdraw(Money) override;
+    virtual Account_Status try_deposit(Money) override;
     virtual void print(std::ostream &os) const override;
+    virtual void format(Print_Buffer &out) const override;
 
     virtual ~Checking_Account() = default;
 };
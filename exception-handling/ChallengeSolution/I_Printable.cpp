@@ -1,8 +1,21 @@
 #include <iostream>
+#include <sstream>
 #include "I_Printable.h"
+#include "Print_Buffer.h"
 
 std::ostream &operator<<(std::ostream &os, const I_Printable &obj) {
     obj.print(os);
     return os;
 }
 
+Print_Buffer &operator<<(Print_Buffer &out, const I_Printable &obj) {
+    obj.format(out);
+    return out;
+}
+
+void I_Printable::format(Print_Buffer &out) const {
+    std::ostringstream os;
+    print(os);
+    out << os.str();
+}
+
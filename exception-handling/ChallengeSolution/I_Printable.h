@@ -2,11 +2,18 @@
 #define _I_PRINTABLE_H_
 #include <iostream>
 
+class Print_Buffer;
+
 class I_Printable
 {
     friend std::ostream &operator<<(std::ostream &os, const I_Printable &obj);
+    friend Print_Buffer &operator<<(Print_Buffer &out, const I_Printable &obj);
 public:
     virtual void print(std::ostream &os) const = 0;
+    
+    // Same text as print, rendered into a Print_Buffer. The default goes through print;
+    // override it to format without a stream.
+    virtual void format(Print_Buffer &out) const;
     virtual ~I_Printable() = default;
 
 };
@@ -0,0 +1,290 @@
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include "Interest_Engine.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Kernels
+
+// Any balance - throws MoneyOverflowException if the interest doesn't fit in a Money
+void interest_scalar(const std::int64_t *cents, const double *factors, std::int64_t *interest, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        double exact = std::nearbyint(static_cast<double>(cents[i]) * factors[i]);
+        if (!(std::fabs(exact) < 9.2e18))
+            throw MoneyOverflowException{};
+        interest[i] = static_cast<std::int64_t>(exact);
+    }
+}
+
+// The SIMD path converts between int64 and double with the 2^52 + 2^51 bias trick, which is
+// exact for integers up to 2^51 in size - plenty for balances, at 2^51 cents (22 trillion dollars).
+// Adding the bias also rounds the product to a whole number, half to even.
+static constexpr double bias = 6755399441055744.0;         // 2^52 + 2^51
+static constexpr double limit = 2251799813685248.0;        // 2^51
+
+#if defined(__AVX2__)
+
+bool interest_kernel(const std::int64_t *cents, const double *factors, std::int64_t *interest, std::size_t count) {
+    const __m256d bias_pd = _mm256_set1_pd(bias);
+    const __m256i bias_epi = _mm256_castpd_si256(bias_pd);
+    const __m256d limit_pd = _mm256_set1_pd(limit);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256i inputs = _mm256_setzero_si256();
+    __m256d too_big = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cents + i));
+        inputs = _mm256_or_si256(inputs, c);
+        __m256d balance = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(c, bias_epi)), bias_pd);
+        __m256d product = _mm256_mul_pd(balance, _mm256_loadu_pd(factors + i));
+        too_big = _mm256_or_pd(too_big, _mm256_cmp_pd(_mm256_andnot_pd(sign, product), limit_pd, _CMP_GE_OQ));
+        __m256i rounded = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(product, bias_pd)), bias_epi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(interest + i), rounded);
+    }
+    std::int64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), inputs);
+    std::int64_t all_inputs = lanes[0] | lanes[1] | lanes[2] | lanes[3];
+    for (std::size_t j = i; j < count; ++j)
+        all_inputs |= cents[j];
+    if ((all_inputs >> 51) != 0 || _mm256_movemask_pd(too_big) != 0)
+        return false;
+    for (; i < count; ++i)
+        interest[i] = static_cast<std::int64_t>(std::nearbyint(static_cast<double>(cents[i]) * factors[i]));
+    return true;
+}
+
+#elif defined(__SSE2__)
+
+bool interest_kernel(const std::int64_t *cents, const double *factors, std::int64_t *interest, std::size_t count) {
+    const __m128d bias_pd = _mm_set1_pd(bias);
+    const __m128i bias_epi = _mm_castpd_si128(bias_pd);
+    const __m128d limit_pd = _mm_set1_pd(limit);
+    const __m128d sign = _mm_set1_pd(-0.0);
+    __m128i inputs = _mm_setzero_si128();
+    __m128d too_big = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cents + i));
+        inputs = _mm_or_si128(inputs, c);
+        __m128d balance = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(c, bias_epi)), bias_pd);
+        __m128d product = _mm_mul_pd(balance, _mm_loadu_pd(factors + i));
+        too_big = _mm_or_pd(too_big, _mm_cmpge_pd(_mm_andnot_pd(sign, product), limit_pd));
+        __m128i rounded = _mm_sub_epi64(_mm_castpd_si128(_mm_add_pd(product, bias_pd)), bias_epi);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(interest + i), rounded);
+    }
+    std::int64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), inputs);
+    std::int64_t all_inputs = lanes[0] | lanes[1];
+    for (std::size_t j = i; j < count; ++j)
+        all_inputs |= cents[j];
+    if ((all_inputs >> 51) != 0 || _mm_movemask_pd(too_big) != 0)
+        return false;
+    for (; i < count; ++i)
+        interest[i] = static_cast<std::int64_t>(std::nearbyint(static_cast<double>(cents[i]) * factors[i]));
+    return true;
+}
+
+#else
+
+bool interest_kernel(const std::int64_t *cents, const double *factors, std::int64_t *interest, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if ((cents[i] >> 51) != 0)
+            return false;
+        double product = static_cast<double>(cents[i]) * factors[i];
+        if (!(std::fabs(product) < limit))
+            return false;
+        interest[i] = static_cast<std::int64_t>(std::nearbyint(product));
+    }
+    return true;
+}
+
+#endif
+
+// Thread pool
+
+Interest_Engine::Interest_Engine(std::size_t thread_count)
+    : generation{0}, stopping{false}, chunks_left{0}, store{nullptr}, periods_per_year{1}, periods{0} {
+    if (thread_count == 0)
+        thread_count = 1;
+    for (std::size_t i = 0; i < thread_count; ++i)
+        workers.push_back(std::make_unique<Worker>());
+    for (std::size_t i = 0; i < thread_count; ++i)
+        threads.emplace_back(&Interest_Engine::work, this, i);
+}
+
+Interest_Engine::~Interest_Engine() {
+    {
+        std::lock_guard<std::mutex> lock {run_mutex};
+        stopping = true;
+    }
+    start_run.notify_all();
+    for (auto &t: threads)
+        t.join();
+}
+
+std::size_t Interest_Engine::get_thread_count() const {
+    return threads.size();
+}
+
+// Each worker waits for a new generation, then works through chunks until none are left anywhere
+void Interest_Engine::work(std::size_t self) {
+    std::size_t seen {0};
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock {run_mutex};
+            start_run.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+        Worker &worker = *workers[self];
+        Chunk chunk;
+        while (next_chunk(self, chunk)) {
+            try {
+                accrue_chunk(worker, chunk);
+            }
+            catch (...) {
+                if (!worker.error)
+                    worker.error = std::current_exception();
+            }
+            if (chunks_left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock {run_mutex};
+                run_done.notify_all();
+            }
+        }
+    }
+}
+
+// Own queue first (front), then steal from the others (back)
+bool Interest_Engine::next_chunk(std::size_t self, Chunk &chunk) {
+    {
+        Worker &own = *workers[self];
+        std::lock_guard<std::mutex> lock {own.mutex};
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.front();
+            own.chunks.pop_front();
+            return true;
+        }
+    }
+    for (std::size_t offset = 1; offset < workers.size(); ++offset) {
+        Worker &victim = *workers[(self + offset) % workers.size()];
+        std::lock_guard<std::mutex> lock {victim.mutex};
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Gather the chunk's balances and growth factors, run the kernel, then credit the interest
+void Interest_Engine::accrue_chunk(Worker &worker, const Chunk &chunk) {
+    std::size_t count = chunk.end - chunk.begin;
+    worker.cents.resize(count);
+    worker.factors.resize(count);
+    worker.credit.resize(count);
+    
+    double last_rate {0};
+    double last_factor {0};
+    auto factor_for = [&](double int_rate) {
+        // accounts mostly share a handful of rates, so pow is rarely called
+        if (int_rate != last_rate) {
+            last_rate = int_rate;
+            last_factor = std::pow(1 + int_rate / 100 / periods_per_year, periods) - 1;
+        }
+        return last_factor;
+    };
+    
+    auto run = [&](auto &accounts) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const Savings_Account &acc = accounts[chunk.begin + i];
+            worker.cents[i] = acc.balance.get_cents();
+            worker.factors[i] = factor_for(acc.int_rate);
+        }
+        if (!interest_kernel(worker.cents.data(), worker.factors.data(), worker.credit.data(), count))
+            interest_scalar(worker.cents.data(), worker.factors.data(), worker.credit.data(), count);
+    };
+    
+    if (chunk.trust) {
+        run(store->trust);
+        for (std::size_t i = 0; i < count; ++i) {
+            Trust_Account &acc = store->trust[chunk.begin + i];
+            Money interest = Money::from_cents(worker.credit[i]);
+            Money credited = Trust_Account::with_bonus(interest);
+            if (credited != interest) {
+                ++worker.totals.bonuses;
+                worker.totals.bonus += credited - interest;
+            }
+            acc.balance += credited;
+            worker.totals.interest += interest;
+        }
+    } else {
+        run(store->savings);
+        for (std::size_t i = 0; i < count; ++i) {
+            Money interest = Money::from_cents(worker.credit[i]);
+            store->savings[chunk.begin + i].balance += interest;
+            worker.totals.interest += interest;
+        }
+    }
+    worker.totals.accounts += count;
+}
+
+Accrual_Result Interest_Engine::accrue(Account_Store &store, int periods_per_year, int periods) {
+    auto start = std::chrono::steady_clock::now();
+    
+    // Everything a worker reads for the run - its parameters and chunks_left - is published under
+    // run_mutex before the first chunk is dealt. A worker still on its way out of the last run can
+    // steal one of these chunks as soon as it is queued, without waiting for the new generation.
+    auto chunks_in = [](std::size_t size) { return (size + chunk_size - 1) / chunk_size; };
+    std::size_t total_chunks {0};
+    if (periods_per_year > 0 && periods > 0)
+        total_chunks = chunks_in(store.savings.size()) + chunks_in(store.trust.size());
+    for (auto &w: workers) {
+        w->totals = Accrual_Result{};
+        w->error = nullptr;
+    }
+    
+    Accrual_Result result;
+    if (total_chunks > 0) {
+        std::unique_lock<std::mutex> lock {run_mutex};
+        this->store = &store;
+        this->periods_per_year = periods_per_year;
+        this->periods = periods;
+        chunks_left.store(total_chunks, std::memory_order_release);
+        
+        // Deal the chunks out round-robin
+        std::size_t dealt {0};
+        auto deal = [&](bool trust, std::size_t size) {
+            for (std::size_t begin = 0; begin < size; begin += chunk_size) {
+                Worker &w = *workers[dealt % workers.size()];
+                std::lock_guard<std::mutex> chunks_lock {w.mutex};
+                w.chunks.push_back(Chunk {trust, begin, (begin + chunk_size < size) ? begin + chunk_size : size});
+                ++dealt;
+            }
+        };
+        deal(false, store.savings.size());
+        deal(true, store.trust.size());
+        
+        ++generation;
+        start_run.notify_all();
+        run_done.wait(lock, [&]() { return chunks_left.load(std::memory_order_acquire) == 0; });
+    }
+    
+    for (auto &w: workers) {
+        if (w->error)
+            std::rethrow_exception(w->error);
+        result.accounts += w->totals.accounts;
+        result.interest += w->totals.interest;
+        result.bonuses += w->totals.bonuses;
+        result.bonus += w->totals.bonus;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.accounts_per_second = (result.seconds > 0) ? result.accounts / result.seconds : 0;
+    return result;
+}
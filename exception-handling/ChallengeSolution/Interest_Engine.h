@@ -0,0 +1,99 @@
+#ifndef _INTEREST_ENGINE_H_
+#define _INTEREST_ENGINE_H_
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Account_Store.h"
+
+// What an interest run did
+struct Accrual_Result {
+    std::size_t accounts {0};           // Savings and Trust accounts credited
+    Money interest;                       // total interest credited
+    std::size_t bonuses {0};              // Trust accounts whose interest earned the bonus
+    Money bonus;                          // total bonus credited
+    double seconds {0};
+    double accounts_per_second {0};
+};
+
+// Parallel interest accrual
+//
+// Credits compound interest to every Savings and Trust account in an Account_Store:
+//     interest = balance * ((1 + int_rate/100 / periods_per_year) ^ periods - 1)
+// rounded to the nearest cent (half to even). Trust accounts get the $50 bonus when the interest
+// credited is $5000 or more, as with any other deposit of that size. Checking accounts earn nothing.
+//
+// The accounts are split into chunks spread over a pool of worker threads. Each worker takes
+// chunks from the front of its own queue and, when that runs dry, steals from the back of
+// another worker's, so a slow chunk doesn't hold up the run. Within a chunk the balances are
+// gathered into a flat array and multiplied by their growth factors with SIMD (SSE2, 2 accounts
+// per instruction - AVX2, 4 at a time, when built with it).
+//
+// The store must not be changed by anything else while a run is going. If a credit would
+// overflow a balance the run throws MoneyOverflowException, after the other chunks finish - the
+// run is not undone, so every other chunk, and the accounts before that one in its chunk, keep
+// their interest. Balances that close to Money's limit (about $92 quadrillion) are not expected;
+// a caller that has to rule it out should check the balances before the run.
+class Interest_Engine {
+private:
+    static constexpr std::size_t chunk_size = 4096;
+    
+    struct Chunk {
+        bool trust;                     // which vector of the store
+        std::size_t begin;
+        std::size_t end;
+    };
+    
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+        std::vector<std::int64_t> cents;        // scratch - the chunk's balances
+        std::vector<double> factors;             // and growth factors
+        std::vector<std::int64_t> credit;        // and their interest
+        Accrual_Result totals;
+        std::exception_ptr error;
+    };
+    
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    
+    std::mutex run_mutex;
+    std::condition_variable start_run;
+    std::condition_variable run_done;
+    std::size_t generation;                 // bumped for every run
+    bool stopping;
+    std::atomic<std::size_t> chunks_left;
+    
+    // The current run
+    Account_Store *store;
+    double periods_per_year;
+    int periods;
+    
+    void work(std::size_t self);
+    bool next_chunk(std::size_t self, Chunk &chunk);
+    void accrue_chunk(Worker &worker, const Chunk &chunk);
+public:
+    explicit Interest_Engine(std::size_t thread_count = std::thread::hardware_concurrency());
+    ~Interest_Engine();
+    Interest_Engine(const Interest_Engine &) = delete;
+    Interest_Engine &operator=(const Interest_Engine &) = delete;
+    
+    std::size_t get_thread_count() const;
+    
+    // Credit periods periods of interest, e.g. accrue(store, 12, 1) for one month
+    Accrual_Result accrue(Account_Store &store, int periods_per_year, int periods = 1);
+};
+
+// interest[i] = cents[i] * factors[i], rounded half to even, for count accounts.
+// Returns false (having written nothing useful) if a balance is negative or too big for the
+// SIMD path; interest_scalar handles any balance.
+bool interest_kernel(const std::int64_t *cents, const double *factors, std::int64_t *interest, std::size_t count);
+void interest_scalar(const std::int64_t *cents, const double *factors, std::int64_t *interest, std::size_t count);
+
+#endif // _INTEREST_ENGINE_H_
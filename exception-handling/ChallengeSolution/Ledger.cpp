@@ -0,0 +1,102 @@
+#include <algorithm>
+#include "Ledger.h"
+
+Ledger::Ledger(std::size_t snapshot_interval)
+    : snapshot_interval{(snapshot_interval > 0) ? snapshot_interval : 1}, now{0} {
+}
+
+// Time only moves forward - an earlier time is ignored
+void Ledger::advance_to(Ledger_Time time) {
+    if (time > now)
+        now = time;
+}
+
+Ledger_Time Ledger::get_time() const {
+    return now;
+}
+
+// Opening an account that is already open just returns its id
+Ledger::Account_Id Ledger::open(std::size_t key, Money opening_balance) {
+    auto found = ids.find(key);
+    if (found != ids.end())
+        return found->second;
+    Account_Id id = static_cast<Account_Id>(accounts.size());
+    accounts.emplace_back();
+    accounts.back().snapshots.push_back(Money{});
+    ids.emplace(key, id);
+    append(id, Entry_Kind::opening, opening_balance);
+    return id;
+}
+
+Ledger::Account_Id Ledger::id_of(std::size_t key) const {
+    return ids.at(key);
+}
+
+void Ledger::append(Account_Id account, Entry_Kind kind, Money change) {
+    Account_Log &acc = accounts.at(account);
+    log.push_back(Ledger_Entry {now, change, account, kind});
+    acc.entries.push_back(log.size() - 1);
+    acc.balance += change;
+    if (acc.entries.size() % snapshot_interval == 0)
+        acc.snapshots.push_back(acc.balance);
+}
+
+// Successful operations only - a declined one changed nothing
+void Ledger::record(const Audit_Record &record) {
+    if (record.status != Account_Status::ok)
+        return;
+    Account_Id id = open(record.index, record.balance_before);
+    Money change = record.balance_after - record.balance_before;
+    if (record.operation == Operation::deposit) {
+        append(id, Entry_Kind::deposit, record.amount);
+        if (change != record.amount)
+            append(id, Entry_Kind::credit, change - record.amount);
+    } else {
+        append(id, Entry_Kind::withdrawal, -record.amount);
+        if (change != -record.amount)
+            append(id, Entry_Kind::fee, change + record.amount);
+    }
+}
+
+Money Ledger::balance(Account_Id account) const {
+    return accounts.at(account).balance;
+}
+
+// The account's entries are in log order, and so in time order
+std::size_t Ledger::entries_until(const Account_Log &acc, Ledger_Time time) const {
+    auto end = std::upper_bound(acc.entries.begin(), acc.entries.end(), time, 
+        [this](Ledger_Time t, std::size_t position) { return t < log[position].time; });
+    return end - acc.entries.begin();
+}
+
+Money Ledger::balance_at(Account_Id account, Ledger_Time time) const {
+    const Account_Log &acc = accounts.at(account);
+    std::size_t count = entries_until(acc, time);
+    std::size_t snapshot = count / snapshot_interval;
+    Money total = acc.snapshots[snapshot];
+    for (std::size_t i = snapshot * snapshot_interval; i < count; ++i)
+        total += log[acc.entries[i]].change;
+    return total;
+}
+
+std::vector<Money> Ledger::replay(Ledger_Time time) const {
+    std::vector<Money> balances(accounts.size());
+    for (const auto &entry: log) {
+        if (entry.time > time)
+            break;
+        balances[entry.account] += entry.change;
+    }
+    return balances;
+}
+
+std::size_t Ledger::size() const {
+    return log.size();
+}
+
+const Ledger_Entry &Ledger::operator[](std::size_t position) const {
+    return log.at(position);
+}
+
+std::size_t Ledger::account_count() const {
+    return accounts.size();
+}
@@ -0,0 +1,87 @@
+#ifndef _LEDGER_H_
+#define _LEDGER_H_
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Account.h"
+#include "Audit_Sink.h"
+
+// Event-sourced account ledger
+//
+// An append-only log of every change to the balances of the accounts opened in it. An
+// account's balance at any point in time is the sum of its entries up to then; the ledger
+// never changes or removes an entry once it is appended.
+//
+// Point-in-time queries don't rescan the log. Each account keeps an index of its own entries
+// in the log, plus a snapshot of its balance after every snapshot_interval of them, so
+// balance_at() is a binary search followed by replaying at most snapshot_interval entries.
+//
+// Entries are stamped with the ledger's current time, e.g. a posting date, set with
+// advance_to(). Time never goes backwards.
+//
+// Accounts are known by a key that stays the same when the account object moves - their
+// position in their Account_Book - never by address, since the book's vector can reallocate.
+//
+// The ledger is also an Audit_Sink: pass it to batch_deposit/batch_withdraw and each successful
+// operation is recorded, split into the amount asked for and the fee, interest or bonus the
+// account's rules added to it. An account the ledger hasn't seen yet is opened with its balance
+// from before the operation.
+
+using Ledger_Time = std::int64_t;
+
+enum class Entry_Kind : std::uint8_t {
+    opening,            // opening balance
+    deposit,
+    withdrawal,
+    fee,                // e.g. the Checking_Account per check fee
+    credit              // interest or bonus added to a deposit
+};
+
+struct Ledger_Entry {
+    Ledger_Time time;
+    Money change;                  // signed - withdrawals and fees are negative
+    std::uint32_t account;
+    Entry_Kind kind;
+};
+
+class Ledger : public Audit_Sink {
+public:
+    using Account_Id = std::uint32_t;
+    static constexpr std::size_t def_snapshot_interval = 64;
+private:
+    struct Account_Log {
+        std::vector<std::size_t> entries;       // positions in log, oldest first
+        std::vector<Money> snapshots;            // snapshots[i] = balance after the first i * interval entries
+        Money balance;
+    };
+    
+    std::vector<Ledger_Entry> log;
+    std::vector<Account_Log> accounts;
+    std::unordered_map<std::size_t, Account_Id> ids;        // by key
+    std::size_t snapshot_interval;
+    Ledger_Time now;
+    
+    std::size_t entries_until(const Account_Log &acc, Ledger_Time time) const;    // number of entries at or before time
+public:
+    explicit Ledger(std::size_t snapshot_interval = def_snapshot_interval);
+    
+    void advance_to(Ledger_Time time);            // stamp entries from now on with time
+    Ledger_Time get_time() const;
+    
+    Account_Id open(std::size_t key, Money opening_balance);     // key - the account's position in its book
+    Account_Id id_of(std::size_t key) const;                     // the account must have been opened
+    
+    void append(Account_Id account, Entry_Kind kind, Money change);
+    virtual void record(const Audit_Record &record) override;
+    
+    Money balance(Account_Id account) const;                                   // now
+    Money balance_at(Account_Id account, Ledger_Time time) const;       // after every entry stamped at or before time
+    std::vector<Money> replay(Ledger_Time time) const;                       // every account's balance_at(time), from one scan of the log
+    
+    std::size_t size() const;
+    const Ledger_Entry &operator[](std::size_t position) const;
+    std::size_t account_count() const;
+};
+
+#endif // _LEDGER_H_
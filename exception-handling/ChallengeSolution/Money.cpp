@@ -0,0 +1,23 @@
+#include "Money.h"
+
+#include <charconv>
+
+// Exactly 2 decimal places, e.g. 1000.00 or -0.05
+char *Money::to_chars(char *first, char *last) const {
+    std::uint64_t magnitude = (cents < 0) ? 0 - static_cast<std::uint64_t>(cents) : static_cast<std::uint64_t>(cents);
+    std::uint64_t fraction = magnitude % 100;
+    if (cents < 0)
+        *first++ = '-';
+    first = std::to_chars(first, last, magnitude / 100).ptr;
+    *first++ = '.';
+    *first++ = static_cast<char>('0' + fraction / 10);
+    *first++ = static_cast<char>('0' + fraction % 10);
+    return first;
+}
+
+// Prints the amount with exactly 2 decimal places, whatever precision the stream is set to
+std::ostream &operator<<(std::ostream &os, const Money &rhs) {
+    char buff[Money::max_chars];
+    os.write(buff, rhs.to_chars(buff, buff + sizeof buff) - buff);
+    return os;
+}
@@ -0,0 +1,96 @@
+#ifndef _MONEY_H_
+#define _MONEY_H_
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include "MoneyOverflowException.h"
+
+// Fixed-point amount of money, held as a whole number of cents
+// Sums are exact, so balances don't drift the way doubles do, and the arithmetic is plain
+// integer arithmetic. Every operation checks for overflow and throws MoneyOverflowException
+// rather than wrapping. A double (e.g. 1000.0 or 12.345) converts implicitly, rounded to the
+// nearest cent; multiplying by a rate rounds the result the same way.
+class Money {
+    friend std::ostream &operator<<(std::ostream &os, const Money &rhs);
+private:
+    std::int64_t cents;
+    
+    static constexpr std::int64_t max_cents = std::numeric_limits<std::int64_t>::max();
+    static constexpr std::int64_t min_cents = std::numeric_limits<std::int64_t>::min();
+    
+    static constexpr std::int64_t round_cents(double cents);   // nearest whole cent, checked
+public:
+    constexpr Money() : cents{0} {}
+    constexpr Money(double amount) : cents{round_cents(amount * 100)} {}
+    static constexpr Money from_cents(std::int64_t cents);
+    
+    constexpr std::int64_t get_cents() const { return cents; }
+    constexpr double to_double() const { return static_cast<double>(cents) / 100; }
+    
+    // Writes the amount with 2 decimal places into [first, last) and returns the end of the
+    // chars written - like std::to_chars, but needs last - first >= max_chars
+    static constexpr std::size_t max_chars = 24;
+    char *to_chars(char *first, char *last) const;
+    
+    constexpr Money &operator+=(Money rhs);
+    constexpr Money &operator-=(Money rhs);
+    constexpr Money operator-() const;
+    constexpr Money operator*(double factor) const;     // rounded to the nearest cent
+    
+    friend constexpr Money operator+(Money lhs, Money rhs) { return lhs += rhs; }
+    friend constexpr Money operator-(Money lhs, Money rhs) { return lhs -= rhs; }
+    friend constexpr bool operator==(Money lhs, Money rhs) { return lhs.cents == rhs.cents; }
+    friend constexpr bool operator!=(Money lhs, Money rhs) { return lhs.cents != rhs.cents; }
+    friend constexpr bool operator<(Money lhs, Money rhs) { return lhs.cents < rhs.cents; }
+    friend constexpr bool operator<=(Money lhs, Money rhs) { return lhs.cents <= rhs.cents; }
+    friend constexpr bool operator>(Money lhs, Money rhs) { return lhs.cents > rhs.cents; }
+    friend constexpr bool operator>=(Money lhs, Money rhs) { return lhs.cents >= rhs.cents; }
+};
+
+constexpr std::int64_t Money::round_cents(double cents) {
+    // 2^63 as a double - anything at or beyond it doesn't fit (this also rejects NaN)
+    constexpr double limit = 9223372036854775808.0;
+    if (!(cents > -limit && cents < limit))
+        throw MoneyOverflowException{};
+    std::int64_t whole = static_cast<std::int64_t>(cents);
+    double rest = cents - static_cast<double>(whole);
+    if (rest >= 0.5 && whole < max_cents)
+        ++whole;
+    else if (rest <= -0.5 && whole > min_cents)
+        --whole;
+    return whole;
+}
+
+constexpr Money Money::from_cents(std::int64_t cents) {
+    Money money;
+    money.cents = cents;
+    return money;
+}
+
+constexpr Money &Money::operator+=(Money rhs) {
+    if ((rhs.cents > 0 && cents > max_cents - rhs.cents) || (rhs.cents < 0 && cents < min_cents - rhs.cents))
+        throw MoneyOverflowException{};
+    cents += rhs.cents;
+    return *this;
+}
+
+constexpr Money &Money::operator-=(Money rhs) {
+    if ((rhs.cents < 0 && cents > max_cents + rhs.cents) || (rhs.cents > 0 && cents < min_cents + rhs.cents))
+        throw MoneyOverflowException{};
+    cents -= rhs.cents;
+    return *this;
+}
+
+constexpr Money Money::operator-() const {
+    if (cents == min_cents)
+        throw MoneyOverflowException{};
+    return from_cents(-cents);
+}
+
+constexpr Money Money::operator*(double factor) const {
+    return from_cents(round_cents(static_cast<double>(cents) * factor));
+}
+
+#endif // _MONEY_H_
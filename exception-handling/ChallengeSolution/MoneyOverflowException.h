@@ -0,0 +1,13 @@
+#ifndef __MONEY_OVERFLOW_EXCEPTION_H__
+#define __MONEY_OVERFLOW_EXCEPTION_H__
+
+class MoneyOverflowException : public std::exception {
+public:
+    MoneyOverflowException() noexcept = default;
+    ~MoneyOverflowException() = default;
+    virtual const char *what() const noexcept {
+        return "Money overflow exception";
+    }
+};
+
+#endif // __MONEY_OVERFLOW_EXCEPTION_H__
@@ -0,0 +1,82 @@
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include "Print_Buffer.h"
+
+Print_Buffer::Print_Buffer(std::ostream &os, std::size_t capacity)
+    : os{os}, buffer(capacity > 64 ? capacity : 64), used{0} {
+}
+
+Print_Buffer::~Print_Buffer() {
+    flush();
+}
+
+void Print_Buffer::flush() {
+    if (used > 0)
+        os.write(buffer.data(), used);
+    used = 0;
+}
+
+char *Print_Buffer::reserve(std::size_t count) {
+    if (used + count > buffer.size())
+        flush();
+    return buffer.data() + used;
+}
+
+Print_Buffer &Print_Buffer::operator<<(std::string_view text) {
+    if (text.size() > buffer.size()) {
+        // too big to buffer - write it straight through
+        flush();
+        os.write(text.data(), text.size());
+        return *this;
+    }
+    std::memcpy(reserve(text.size()), text.data(), text.size());
+    used += text.size();
+    return *this;
+}
+
+Print_Buffer &Print_Buffer::operator<<(const char *text) {
+    return *this << std::string_view{text};
+}
+
+Print_Buffer &Print_Buffer::operator<<(const std::string &text) {
+    return *this << std::string_view{text};
+}
+
+Print_Buffer &Print_Buffer::operator<<(char c) {
+    *reserve(1) = c;
+    ++used;
+    return *this;
+}
+
+Print_Buffer &Print_Buffer::operator<<(int value) {
+    return *this << static_cast<long long>(value);
+}
+
+Print_Buffer &Print_Buffer::operator<<(long long value) {
+    constexpr std::size_t max_chars = 24;
+    char *first = reserve(max_chars);
+    used += std::to_chars(first, first + max_chars, value).ptr - first;
+    return *this;
+}
+
+Print_Buffer &Print_Buffer::operator<<(Money amount) {
+    char *first = reserve(Money::max_chars);
+    used += amount.to_chars(first, first + Money::max_chars) - first;
+    return *this;
+}
+
+Print_Buffer &Print_Buffer::fixed(double value, int precision) {
+    constexpr std::size_t max_chars = 64;
+    char *first = reserve(max_chars);
+    auto result = std::to_chars(first, first + max_chars, value, std::chars_format::fixed, precision);
+    if (result.ec != std::errc{}) {
+        // huge values - too many digits for the fast path
+        std::ostringstream text;
+        text.precision(precision);
+        text << std::fixed << value;
+        return *this << text.str();
+    }
+    used += result.ptr - first;
+    return *this;
+}
@@ -0,0 +1,42 @@
+#ifndef _PRINT_BUFFER_H_
+#define _PRINT_BUFFER_H_
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Money.h"
+
+// Buffered output for printing many objects at once
+// Text and numbers are rendered straight into a char buffer (numbers with std::to_chars, so
+// no stream formatting state is read or changed) and the buffer goes to the stream in one
+// write whenever it fills up, on flush() and when the Print_Buffer is destroyed.
+// The buffer is allocated once, so one Print_Buffer can be reused for any amount of output.
+class Print_Buffer {
+private:
+    std::ostream &os;
+    std::vector<char> buffer;
+    std::size_t used;
+    
+    char *reserve(std::size_t count);           // room for count more chars, flushing if needed
+public:
+    static constexpr std::size_t def_capacity = 64 * 1024;
+    
+    explicit Print_Buffer(std::ostream &os, std::size_t capacity = def_capacity);
+    ~Print_Buffer();
+    Print_Buffer(const Print_Buffer &) = delete;
+    Print_Buffer &operator=(const Print_Buffer &) = delete;
+    
+    Print_Buffer &operator<<(std::string_view text);
+    Print_Buffer &operator<<(const char *text);
+    Print_Buffer &operator<<(const std::string &text);
+    Print_Buffer &operator<<(char c);
+    Print_Buffer &operator<<(int value);
+    Print_Buffer &operator<<(long long value);
+    Print_Buffer &operator<<(Money amount);
+    Print_Buffer &fixed(double value, int precision = 2);      // like os << std::fixed << value
+    
+    void flush();           // write out everything buffered so far
+};
+
+#endif // _PRINT_BUFFER_H_
@@ -1,6 +1,6 @@
 #include "Savings_Account.h"
 
-Savings_Account::Savings_Account(std::string name, double balance, double int_rate)
+Savings_Account::Savings_Account(std::string name, Money balance, double int_rate)
     : Account {name, balance}, int_rate{int_rate} {
 }
 
@@ -8,18 +8,25 @@ Savings_Account::Savings_Account(std::string name, double balance, double int_ra
 //      Amount supplied to deposit will be incremented by (amount * int_rate/100) 
 //      and then the updated amount will be deposited
 //
-bool Savings_Account::deposit(double amount) {
-    amount += amount * (int_rate/100);
-    return Account::deposit(amount);
+Account_Status Savings_Account::try_deposit(Money amount) {
+    return Account::try_deposit(with_interest(amount, int_rate));
 }
 
-bool Savings_Account::withdraw(double amount) {
-    return Account::withdraw(amount);
+Account_Status Savings_Account::try_withdraw(Money amount) {
+    return Account::try_withdraw(amount);
+}
+
+double Savings_Account::get_int_rate() const {
+    return int_rate;
 }
 
 
 void Savings_Account::print(std::ostream &os) const {
     os.precision(2);
     os << std::fixed;
-    os << "[Savings_Account: " << name << ": " << balance << ", " << int_rate << "]";
+    os << "[Savings_Account: " << name << ": " << get_balance() << ", " << int_rate << "]";
+}
+
+void Savings_Account::format(Print_Buffer &out) const {
+    (out << "[Savings_Account: " << name << ": " << get_balance() << ", ").fixed(int_rate) << "]";
 }
@@ -3,17 +3,25 @@
 #include "Account.h"
 
 class Savings_Account: public Account {
+    friend class Account_Store;
+    friend class Interest_Engine;
+    friend class Account_Table;
 private:
     static constexpr const char *def_name = "Unnamed Savings Account";
-    static constexpr double def_balance = 0.0;
+    static constexpr Money def_balance {};
     static constexpr double def_int_rate = 0.0;
 protected:
     double int_rate;
 public:
-    Savings_Account(std::string name = def_name, double balance =def_balance, double int_rate = def_int_rate);    
-    virtual bool deposit(double amount) override;
-    virtual bool withdraw(double amount) override;
+    // Amount credited for a deposit, interest included
+    static Money with_interest(Money amount, double int_rate) { return amount + amount * (int_rate/100); }
+    
+    Savings_Account(std::string name = def_name, Money balance =def_balance, double int_rate = def_int_rate);    
+    virtual Account_Status try_deposit(Money amount) override;
+    virtual Account_Status try_withdraw(Money amount) override;
+    double get_int_rate() const;
     virtual void print(std::ostream &os) const override;
+    virtual void format(Print_Buffer &out) const override;
 
     virtual ~Savings_Account() = default;
 };
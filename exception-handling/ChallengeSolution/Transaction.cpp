@@ -0,0 +1,99 @@
+#include <bit>            // C++20
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include "Transaction.h"
+
+// Lock stripes - each on its own cache line so threads locking neighbouring stripes don't
+// contend on the same line. A set of stripes is a 64-bit mask, one bit per stripe.
+static constexpr std::size_t stripe_count = 64;
+
+struct alignas(64) Lock_Stripe {
+    std::mutex mutex;
+};
+
+static Lock_Stripe stripes[stripe_count];
+
+static std::size_t stripe_of(const Account *account) {
+    return (std::hash<const Account *>{}(account) >> 6) % stripe_count;
+}
+
+// Locks a set of stripes in ascending order and unlocks them when it goes out of scope
+class Stripe_Guard {
+private:
+    std::uint64_t held;
+public:
+    explicit Stripe_Guard(std::uint64_t needed) : held{needed} {
+        for (std::uint64_t left = held; left != 0; left &= left - 1)
+            stripes[std::countr_zero(left)].mutex.lock();
+    }
+    ~Stripe_Guard() {
+        for (std::uint64_t left = held; left != 0; left &= left - 1)
+            stripes[std::countr_zero(left)].mutex.unlock();
+    }
+    Stripe_Guard(const Stripe_Guard &) = delete;
+    Stripe_Guard &operator=(const Stripe_Guard &) = delete;
+};
+
+// Applies count legs with their accounts' stripes locked. saved has room for 2 states per leg:
+// the accounts of each leg are saved before it runs, and if a leg is declined (or throws) every
+// saved state is restored, latest first, so each account ends up as it was before the first leg.
+bool Transaction::apply(const Leg *legs, std::size_t count, Account_State *saved) {
+    std::uint64_t needed {0};
+    for (std::size_t i = 0; i < count; ++i)
+        needed |= (std::uint64_t{1} << stripe_of(legs[i].from)) | (std::uint64_t{1} << stripe_of(legs[i].to));
+    Stripe_Guard guard {needed};
+    
+    std::size_t done {0};
+    auto undo = [&]() {
+        for (std::size_t i = done; i-- > 0; ) {
+            legs[i].to->restore_state(saved[2 * i + 1]);
+            legs[i].from->restore_state(saved[2 * i]);
+        }
+    };
+    try {
+        for (; done < count; ++done) {
+            const Leg &leg = legs[done];
+            saved[2 * done] = leg.from->save_state();
+            saved[2 * done + 1] = leg.to->save_state();
+            bool ok = leg.from->try_withdraw(leg.amount) == Account_Status::ok 
+                      && leg.to->try_deposit(leg.amount) == Account_Status::ok;
+            if (!ok) {
+                ++done;         // the failed leg may have withdrawn already
+                undo();
+                return false;
+            }
+        }
+    }
+    catch (...) {
+        done = (done < count) ? done + 1 : count;
+        undo();
+        throw;
+    }
+    return true;
+}
+
+Transaction &Transaction::transfer(Account &from, Account &to, Money amount) {
+    legs.push_back(Leg {&from, &to, amount});
+    return *this;
+}
+
+std::size_t Transaction::size() const {
+    return legs.size();
+}
+
+void Transaction::clear() {
+    legs.clear();
+}
+
+bool Transaction::commit() {
+    saved.resize(2 * legs.size());
+    return apply(legs.data(), legs.size(), saved.data());
+}
+
+// Single transfer - no allocation
+bool transfer(Account &from, Account &to, Money amount) {
+    Transaction::Leg leg {&from, &to, amount};
+    Account_State saved[2];
+    return Transaction::apply(&leg, 1, saved);
+}
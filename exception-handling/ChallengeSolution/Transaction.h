@@ -0,0 +1,42 @@
+#ifndef _TRANSACTION_H_
+#define _TRANSACTION_H_
+#include <cstddef>
+#include <vector>
+#include "Account.h"
+
+// Transfers between accounts
+//
+// A transaction is a list of legs, each withdrawing an amount from one account and depositing
+// it to another under the usual rules of both (fees, interest, bonuses, withdrawal limits).
+// commit() applies every leg or none: if any withdrawal or deposit is declined, every account
+// the transaction touched is put back as it was.
+//
+// While a transaction runs it holds the locks of all its accounts. Accounts map onto a fixed
+// table of lock stripes, and a transaction always takes its stripes in ascending order, so
+// transactions over overlapping accounts can't deadlock however their legs are ordered.
+// Accounts that transactions use should only be changed through transactions.
+class Transaction {
+private:
+    struct Leg {
+        Account *from;
+        Account *to;
+        Money amount;
+    };
+    std::vector<Leg> legs;
+    std::vector<Account_State> saved;       // reused across commits
+    
+    static bool apply(const Leg *legs, std::size_t count, Account_State *saved);
+public:
+    Transaction &transfer(Account &from, Account &to, Money amount);      // add a leg
+    std::size_t size() const;
+    void clear();
+    
+    bool commit();          // true if every leg went through
+    
+    // Single transfer without building a Transaction
+    friend bool transfer(Account &from, Account &to, Money amount);
+};
+
+bool transfer(Account &from, Account &to, Money amount);
+
+#endif // _TRANSACTION_H_
@@ -1,31 +1,101 @@
 #include "Trust_Account.h"
 
-Trust_Account::Trust_Account(std::string name, double balance, double int_rate)
+Trust_Account::Trust_Account(std::string name, Money balance, double int_rate)
     : Savings_Account {name, balance, int_rate}, num_withdrawals {0}  {
         
 }
 
 // Deposit additional $50 bonus when amount >= $5000
-bool Trust_Account::deposit(double amount) {
-    if (amount >= bonus_threshold)
-        amount += bonus_amount;
-    return Savings_Account::deposit(amount);
+Account_Status Trust_Account::try_deposit(Money amount) {
+    return Savings_Account::try_deposit(with_bonus(amount));
 }
     
-// Only allowed 3 withdrawals, each can be up to a maximum of 20% of the account's value
-bool Trust_Account::withdraw(double amount) {
-    if (num_withdrawals >= max_withdrawals || (amount > balance * max_withdraw_percent))
-        return false;
-    else {
+// Only allowed 3 withdrawals, each can be up to a maximum of 20% of the account's value,
+// and no more than the withdrawal limit per period if one is set
+Account_Status Trust_Account::try_withdraw(Money amount) {
+    return try_withdraw_at(amount, Withdrawal_Window::Clock::now());
+}
+
+// A withdrawal first reserves one of the 3 (and one from the period's limit), then checks the 20% limit against the balance it
+// takes the amount from, and gives the reservation back if that fails. Concurrent withdrawals
+// can never make more than 3 or exceed 20% - but one that is later given back can briefly
+// make another see the limit of 3 as reached, and fail.
+Account_Status Trust_Account::try_withdraw_at(Money amount, Withdrawal_Window::Clock::time_point time) {
+    if (!reserve_withdrawal(Withdrawal_Window::to_ticks(time)))
+        return Account_Status::declined;
+    bool withdrew = change_balance([amount](Money current, Money &next) {
+        if (!within_withdraw_limit(amount, current))
+            return false;
+        next = current - amount;
+        return next >= Money{};
+    });
+    if (!withdrew) {
+        cancel_withdrawal();
+        return Account_Status::declined;
+    }
+    return Account_Status::ok;
+}
+
+bool Trust_Account::reserve_withdrawal(std::int64_t now) {
+    if (!concurrent) {
+        if (num_withdrawals >= max_withdrawals || !window.take(now, false))
+            return false;
         ++num_withdrawals;
-        return Savings_Account::withdraw(amount);
+        return true;
+    }
+    std::atomic_ref<int> shared {num_withdrawals};
+    int count = shared.load(std::memory_order_relaxed);
+    do {
+        if (count >= max_withdrawals)
+            return false;
+    } while (!shared.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+    if (!window.take(now, true)) {
+        shared.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
     }
+    return true;
+}
+
+void Trust_Account::cancel_withdrawal() {
+    window.give_back(concurrent);
+    if (concurrent)
+        std::atomic_ref<int>{num_withdrawals}.fetch_sub(1, std::memory_order_acq_rel);
+    else
+        --num_withdrawals;
+}
+
+void Trust_Account::set_withdrawal_limit(int limit, std::chrono::nanoseconds period) {
+    window.set_limit(limit, period);
+}
+
+int Trust_Account::get_num_withdrawals() const {
+    if (!concurrent)
+        return num_withdrawals;
+    return std::atomic_ref<int>{const_cast<int &>(num_withdrawals)}.load(std::memory_order_acquire);
+}
+
+Account_State Trust_Account::save_state() const {
+    return Account_State {get_balance(), get_num_withdrawals(), window.get_state()};
+}
+
+void Trust_Account::restore_state(const Account_State &state) {
+    Savings_Account::restore_state(state);
+    if (concurrent)
+        std::atomic_ref<int>{num_withdrawals}.store(state.num_withdrawals, std::memory_order_release);
+    else
+        num_withdrawals = state.num_withdrawals;
+    window.set_state(state.withdrawal_window);
 }
 
 void Trust_Account::print(std::ostream &os) const {
     os.precision(2);
     os << std::fixed;
-    os << "[Trust Account: " << name << ": " << balance << ", " << int_rate 
-        << "%, withdrawals: " << num_withdrawals <<  "]";
+    os << "[Trust Account: " << name << ": " << get_balance() << ", " << int_rate 
+        << "%, withdrawals: " << get_num_withdrawals() <<  "]";
+}
+
+void Trust_Account::format(Print_Buffer &out) const {
+    (out << "[Trust Account: " << name << ": " << get_balance() << ", ").fixed(int_rate) 
+        << "%, withdrawals: " << get_num_withdrawals() <<  "]";
 }
 
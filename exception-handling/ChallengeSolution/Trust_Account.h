@@ -1,28 +1,61 @@
 #ifndef _TRUST_ACCOUNT_H_
 #define _TRUST_ACCOUNT_H_
 
+#include <chrono>
 #include "Savings_Account.h"
+#include "Withdrawal_Window.h"
 
-class Trust_Account : public Savings_Account {
+class Trust_Account final : public Savings_Account {
+    friend class Account_Store;
+    friend class Interest_Engine;
+    friend class Account_Table;
 private:
     static constexpr const char *def_name = "Unnamed Trust Account";
-    static constexpr double def_balance = 0.0;
+    static constexpr Money def_balance {};
     static constexpr double def_int_rate = 0.0;
-    static constexpr double bonus_amount = 50.0;
-    static constexpr double bonus_threshold = 5000.0;
+    static constexpr Money bonus_amount = 50.0;
+    static constexpr Money bonus_threshold = 5000.0;
     static constexpr int max_withdrawals = 3;
     static constexpr double max_withdraw_percent = 0.2;
 protected:
     int num_withdrawals;
+    Withdrawal_Window window;
+    
+    bool reserve_withdrawal(std::int64_t now);      // count one more withdrawal, if there are any left
+    void cancel_withdrawal();                      // uncount a reserved withdrawal that didn't go through
 public:
-    Trust_Account(std::string name = def_name,  double balance = def_balance, double int_rate = def_int_rate);
+    // Amount deposited, $50 bonus included for deposits of $5000 or more
+    static Money with_bonus(Money amount) { return (amount >= bonus_threshold) ? amount + bonus_amount : amount; }
+    
+    // true if a withdrawal of amount is within 20% of balance
+    static bool within_withdraw_limit(Money amount, Money balance) { return amount <= balance * max_withdraw_percent; }
+    
+    // true if another withdrawal of amount is within the limits
+    static bool withdrawal_allowed(Money amount, Money balance, int num_withdrawals) {
+        return num_withdrawals < max_withdrawals && within_withdraw_limit(amount, balance);
+    }
+    
+    Trust_Account(std::string name = def_name,  Money balance = def_balance, double int_rate = def_int_rate);
     
     // Deposits of $5000.00 or more will receive $50 bonus
-    virtual bool deposit(double amount) override;
+    virtual Account_Status try_deposit(Money amount) override;
     
     // Only allowed maximum of 3 withdrawals, each can be up to a maximum of 20% of the account's value
-    virtual bool withdraw(double amount) override;
+    virtual Account_Status try_withdraw(Money amount) override;
+    Account_Status try_withdraw_at(Money amount, Withdrawal_Window::Clock::time_point time);
+    
+    // Also limit withdrawals to an average of limit per period (e.g. 2 a day), on top of the 3 in
+    // total; a limit of 0 removes it. A rate with bursts of up to limit, not a sliding window -
+    // checked in constant time, see Withdrawal_Window.
+    void set_withdrawal_limit(int limit, std::chrono::nanoseconds period);
+    
     virtual void print(std::ostream &os) const override;
+    virtual void format(Print_Buffer &out) const override;
+    
+    int get_num_withdrawals() const;
+    
+    virtual Account_State save_state() const override;
+    virtual void restore_state(const Account_State &state) override;
 
     virtual ~Trust_Account() = default;
 };
@@ -0,0 +1,105 @@
+#ifndef _WITHDRAWAL_WINDOW_H_
+#define _WITHDRAWAL_WINDOW_H_
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+// Withdrawal rate limit
+//
+// Limits withdrawals to an average of limit per period, checked in constant time however many
+// withdrawals there have been. It is a token bucket kept as a single number (the generic cell
+// rate algorithm): the bucket holds limit withdrawals and one comes back every period / limit.
+// That is a rate, not a sliding window - a burst of up to limit can be taken at once, and one
+// more every period / limit after that, so a period can see more than limit withdrawals when it
+// straddles a burst. E.g. with 2 a day, withdrawals at 9:00, 9:01 and 21:01 are all allowed;
+// over any longer stretch there are never more than limit per period plus the one burst.
+// The number is the time at which the bucket would be full again ("theoretical arrival time"),
+// which makes a check one compare and an update one add - and lets concurrent withdrawals
+// update it with a single compare-and-swap.
+//
+// Times are nanoseconds on std::chrono::steady_clock. A window with no limit allows everything.
+class Withdrawal_Window {
+public:
+    using Clock = std::chrono::steady_clock;
+private:
+    std::int64_t interval;          // period / limit rounded up - how often a withdrawal comes back, 0 for no limit
+    std::int64_t tolerance;         // period - interval - how far ahead of now the full time may run
+    std::int64_t full_at;           // when the bucket is full again
+    
+    // The new full_at if a withdrawal at now is allowed
+    bool admit(std::int64_t current, std::int64_t now, std::int64_t &next) const {
+        if (current - tolerance > now)
+            return false;
+        next = ((current > now) ? current : now) + interval;
+        return true;
+    }
+public:
+    Withdrawal_Window() : interval{0}, tolerance{0}, full_at{0} {}
+    
+    static std::int64_t now() { return to_ticks(Clock::now()); }
+    static std::int64_t to_ticks(Clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+    
+    // Average of limit withdrawals per period, bursts of up to limit; a limit of 0 removes it.
+    // The interval is rounded up, so a period shorter than limit nanoseconds still limits.
+    // Throws std::invalid_argument if there is a limit and period isn't positive.
+    void set_limit(int limit, std::chrono::nanoseconds period) {
+        if (limit > 0 && period.count() <= 0)
+            throw std::invalid_argument {"Withdrawal limit period must be positive"};
+        interval = (limit > 0) ? (period.count() + limit - 1) / limit : 0;
+        tolerance = (limit > 0) ? period.count() - interval : 0;
+        full_at = 0;
+    }
+    bool limited() const { return interval > 0; }
+    
+    // Take a withdrawal at now, if one is left - concurrent for accounts shared between threads
+    bool take(std::int64_t now, bool concurrent) {
+        if (interval == 0)
+            return true;
+        std::int64_t next;
+        if (!concurrent) {
+            if (!admit(full_at, now, next))
+                return false;
+            full_at = next;
+            return true;
+        }
+        std::atomic_ref<std::int64_t> shared {full_at};
+        std::int64_t current = shared.load(std::memory_order_relaxed);
+        do {
+            if (!admit(current, now, next))
+                return false;
+        } while (!shared.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+        return true;
+    }
+    
+    // Give back a taken withdrawal that didn't go through
+    void give_back(bool concurrent) {
+        if (interval == 0)
+            return;
+        if (concurrent)
+            std::atomic_ref<std::int64_t>{full_at}.fetch_sub(interval, std::memory_order_acq_rel);
+        else
+            full_at -= interval;
+    }
+    
+    // Branch-free check and take for the batch kernels - takes a withdrawal only if ok is
+    // already true and one is left, returning whether it did
+    bool take_if(bool ok, std::int64_t now) {
+        bool left = (interval == 0) | (full_at - tolerance <= now);
+        std::int64_t next = ((full_at > now) ? full_at : now) + interval;
+        ok = ok & left;
+        full_at = (ok & (interval != 0)) ? next : full_at;
+        return ok;
+    }
+    
+    std::int64_t get_state() const {
+        return std::atomic_ref<std::int64_t>{const_cast<std::int64_t &>(full_at)}.load(std::memory_order_acquire);
+    }
+    void set_state(std::int64_t state) {
+        std::atomic_ref<std::int64_t>{full_at}.store(state, std::memory_order_release);
+    }
+};
+
+#endif // _WITHDRAWAL_WINDOW_H_
@@ -36,6 +36,16 @@ int main() {
     catch (const InsufficientFundsException &ex) {
         std::cerr << ex.what() << std::endl;
     }
+    
+    // Accounts of every type in one container, stored by value
+    Account_Book accounts;
+    accounts.open<Savings_Account>("Larry", 2000.0, 5.0);
+    accounts.open<Checking_Account>("Curly", 100.0);
+    accounts.open<Trust_Account>("Moe", 10000.0, 3.0);
+    display(accounts);
+    deposit(accounts, 1000.0);
+    withdraw(accounts, 2000.0);
+    
     std::cout << "Program completed successfully" << std::endl;
     return 0;
 }
@@ -0,0 +1,321 @@
+// Mystring benchmark harness
+// Times the common Mystring operations next to the same work done with std::string, counting
+// heap allocations and Mystring copies/moves per operation, then runs the case conversion and
+// comparison kernels over megabyte-sized strings.
+//
+// Build against the Task-Solution2 Mystring with optimizations and tracing on, e.g.
+//   g++ -std=c++20 -O2 -DMYSTRING_TRACE -I../Task-Solution2 main.cpp ../Task-Solution2/Mystring.cpp ../Task-Solution2/Mystring_view.cpp ../Task-Solution2/Mystring_Kernels.cpp -o bench
+// Run ./bench for everything, ./bench ops or ./bench kernels for one part.
+// Without -DMYSTRING_TRACE the copy and move columns show "-".
+// C++20 is needed for the map lookups by C-style string (heterogeneous find).
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_Kernels.h"
+
+using namespace std;
+
+// Every heap allocation in the program goes through here, so both Mystring (via the default
+// memory resource) and std::string are counted the same way
+static long allocation_count {0};
+
+void *operator new(size_t size) {
+    ++allocation_count;
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw bad_alloc{};
+}
+
+// std::pmr::new_delete_resource asks for aligned allocations
+void *operator new(size_t size, align_val_t align) {
+    ++allocation_count;
+    size_t alignment = static_cast<size_t>(align);
+    size = (size + alignment - 1) / alignment * alignment;
+    if (void *p = aligned_alloc(alignment, size ? size : alignment))
+        return p;
+    throw bad_alloc{};
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete(void *p, align_val_t) noexcept { free(p); }
+void operator delete(void *p, size_t, align_val_t) noexcept { free(p); }
+
+// Stops the optimizer from throwing away results
+static volatile size_t sink {0};
+
+// Runs f reps times and returns the average time per run in microseconds
+template <typename Func>
+double time_us(int reps, Func f) {
+    auto start = chrono::steady_clock::now();
+    for (int i=0; i<reps; i++)
+        f();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, micro>(stop - start).count() / reps;
+}
+
+void report(const string &name, size_t bytes, double us) {
+    cout << setw(34) << left << name 
+         << setw(12) << right << fixed << setprecision(1) << us << " us"
+         << setw(12) << (bytes / us) << " MB/s" << endl;
+}
+
+// The per-byte tolower loop Mystring used before the kernels, minus its strlen call
+// on every iteration (which makes the original quadratic and unusable at these sizes)
+void to_lower_per_byte(char *buff, size_t len) {
+    for (size_t i=0; i<len; i++)
+        buff[i] = tolower(static_cast<unsigned char>(buff[i]));
+}
+
+struct Measurement {
+    double ns;              // per operation
+    double allocations;   // per operation
+    double copies;         // Mystring copy constructions + copy assignments per operation
+    double moves;          // Mystring move constructions + move assignments per operation
+};
+
+long trace_copies() {
+#ifdef MYSTRING_TRACE
+    return Mystring_trace::copy_constructs + Mystring_trace::copy_assigns;
+#else
+    return -1;
+#endif
+}
+
+long trace_moves() {
+#ifdef MYSTRING_TRACE
+    return Mystring_trace::move_constructs + Mystring_trace::move_assigns;
+#else
+    return -1;
+#endif
+}
+
+// Runs f ops times and averages time, allocations, copies and moves over the runs
+template <typename Func>
+Measurement measure(long ops, Func f) {
+    f();        // warm up
+    long allocs_before = allocation_count;
+    long copies_before = trace_copies();
+    long moves_before = trace_moves();
+    auto start = chrono::steady_clock::now();
+    for (long i=0; i<ops; i++)
+        f();
+    auto stop = chrono::steady_clock::now();
+    Measurement m;
+    m.ns = chrono::duration<double, nano>(stop - start).count() / ops;
+    m.allocations = static_cast<double>(allocation_count - allocs_before) / ops;
+    m.copies = (copies_before < 0) ? -1 : static_cast<double>(trace_copies() - copies_before) / ops;
+    m.moves = (moves_before < 0) ? -1 : static_cast<double>(trace_moves() - moves_before) / ops;
+    return m;
+}
+
+void print_count(double count) {
+    if (count < 0)
+        cout << setw(8) << "-";
+    else
+        cout << setw(8) << setprecision(2) << count;
+}
+
+void compare(const string &name, const Measurement &mine, const Measurement &std_string) {
+    cout << setw(32) << left << name << right << fixed
+         << setw(10) << setprecision(1) << mine.ns;
+    print_count(mine.allocations);
+    print_count(mine.copies);
+    print_count(mine.moves);
+    cout << setw(12) << setprecision(1) << std_string.ns;
+    print_count(std_string.allocations);
+    cout << setw(9) << setprecision(2) << (mine.ns / std_string.ns) << "x" << endl;
+}
+
+// Everyday operations on short and medium strings, next to std::string doing the same work
+void operation_benchmarks() {
+    const long ops {200000};
+    const char *short_text = "Frank";
+    const char *long_text = "The Quick Brown Fox Jumps Over The Lazy Dog 0123456789";
+    
+    cout << "\n=== Operations (" << ops << " runs each) =====================================" << endl;
+    cout << setw(32) << left << "" << right
+         << setw(10) << "ns/op" << setw(8) << "allocs" << setw(8) << "copies" << setw(8) << "moves"
+         << setw(12) << "std ns/op" << setw(8) << "allocs" << setw(10) << "ratio" << endl;
+    
+    compare("construct short",
+        measure(ops, [&]() { Mystring s {short_text}; sink = sink + s.get_length(); }),
+        measure(ops, [&]() { string s {short_text}; sink = sink + s.size(); }));
+    compare("construct long",
+        measure(ops, [&]() { Mystring s {long_text}; sink = sink + s.get_length(); }),
+        measure(ops, [&]() { string s {long_text}; sink = sink + s.size(); }));
+    
+    Mystring my_long {long_text};
+    string std_long {long_text};
+    compare("copy long",
+        measure(ops, [&]() { Mystring s {my_long}; sink = sink + s.get_length(); }),
+        measure(ops, [&]() { string s {std_long}; sink = sink + s.size(); }));
+    Mystring my_shared {long_text};
+    my_shared.enable_sharing();
+    compare("copy long, sharing enabled",
+        measure(ops, [&]() { Mystring s {my_shared}; sink = sink + s.get_length(); }),
+        measure(ops, [&]() { string s {std_long}; sink = sink + s.size(); }));
+    compare("move long",
+        measure(ops, [&]() { Mystring a {long_text}; Mystring b {std::move(a)}; sink = sink + b.get_length(); }),
+        measure(ops, [&]() { string a {long_text}; string b {std::move(a)}; sink = sink + b.size(); }));
+    
+    Mystring m1 {"alpha-"}, m2 {"beta-"}, m3 {"gamma-"}, m4 {"delta"};
+    string s1 {"alpha-"}, s2 {"beta-"}, s3 {"gamma-"}, s4 {"delta"};
+    Mystring my_result;
+    string std_result;
+    compare("assign a + b + c + d",
+        measure(ops, [&]() { my_result = m1 + m2 + m3 + m4; sink = sink + my_result.get_length(); }),
+        measure(ops, [&]() { std_result = s1 + s2 + s3 + s4; sink = sink + std_result.size(); }));
+    compare("append +=",
+        measure(ops, [&]() { Mystring s {m1}; s += m2; s += m3; s += m4; sink = sink + s.get_length(); }),
+        measure(ops, [&]() { string s {s1}; s += s2; s += s3; s += s4; sink = sink + s.size(); }));
+    
+    Mystring my_unit {"-=-"};
+    string std_unit {"-=-"};
+    compare("repeat * 40",
+        measure(ops, [&]() { Mystring s = my_unit * 40; sink = sink + s.get_length(); }),
+        measure(ops, [&]() { 
+            string s; 
+            s.reserve(std_unit.size() * 40);
+            for (int i=0; i<40; i++) 
+                s += std_unit;
+            sink = sink + s.size(); 
+        }));
+    
+    compare("lowercase copy",
+        measure(ops, [&]() { Mystring s = -my_long; sink = sink + s.get_length(); }),
+        measure(ops, [&]() { 
+            string s {std_long}; 
+            transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+            sink = sink + s.size(); 
+        }));
+    compare("uppercase in place",
+        measure(ops, [&]() { ++my_long; sink = sink + my_long.get_length(); }),
+        measure(ops, [&]() { 
+            transform(std_long.begin(), std_long.end(), std_long.begin(), [](unsigned char c) { return static_cast<char>(toupper(c)); });
+            sink = sink + std_long.size(); 
+        }));
+    
+    Mystring my_other {long_text};
+    string std_other {long_text};
+    ++my_other;
+    transform(std_other.begin(), std_other.end(), std_other.begin(), [](unsigned char c) { return static_cast<char>(toupper(c)); });
+    compare("== equal strings",
+        measure(ops, [&]() { sink = sink + (my_long == my_other); }),
+        measure(ops, [&]() { sink = sink + (std_long == std_other); }));
+    compare("< equal strings",
+        measure(ops, [&]() { sink = sink + (my_long < my_other); }),
+        measure(ops, [&]() { sink = sink + (std_long < std_other); }));
+    compare("== C-style string",
+        measure(ops, [&]() { sink = sink + (m4 == "delta"); }),
+        measure(ops, [&]() { sink = sink + (s4 == "delta"); }));
+    
+    compare("vector of 100, push_back",
+        measure(ops / 100, [&]() { 
+            vector<Mystring> v; 
+            for (int i=0; i<100; i++) 
+                v.push_back(Mystring{long_text}); 
+            sink = sink + v.size(); 
+        }),
+        measure(ops / 100, [&]() { 
+            vector<string> v; 
+            for (int i=0; i<100; i++) 
+                v.push_back(string{long_text}); 
+            sink = sink + v.size(); 
+        }));
+    
+    // The Mystring key caches its hash; std::hash<string> rehashes every time
+    compare("hash long",
+        measure(ops, [&]() { sink = sink + std::hash<Mystring>{}(my_long); }),
+        measure(ops, [&]() { sink = sink + std::hash<string>{}(std_long); }));
+    
+    unordered_map<Mystring, int, Mystring_hash, Mystring_equal> my_map;
+    unordered_map<string, int> std_map;
+    for (const char *key : {short_text, long_text, "alpha", "bravo", "charlie", "delta"}) {
+        my_map.emplace(key, 1);
+        std_map.emplace(key, 1);
+    }
+    compare("map find by C-style string",
+        measure(ops, [&]() { sink = sink + my_map.find(long_text)->second; }),
+        measure(ops, [&]() { sink = sink + std_map.find(long_text)->second; }));
+    const Mystring my_key {long_text};
+    const string std_key {long_text};
+    compare("map find by key",
+        measure(ops, [&]() { sink = sink + my_map.find(my_key)->second; }),
+        measure(ops, [&]() { sink = sink + std_map.find(std_key)->second; }));
+}
+
+// Case conversion and comparison kernels over megabyte-sized strings
+void kernel_benchmarks() {
+    const int reps {20};
+    const Mystring unit {"The Quick Brown Fox Jumps Over The Lazy Dog 0123456789 "};
+    
+    for (int megabytes : {1, 16}) {
+        int repeats = megabytes * 1024 * 1024 / unit.get_length();
+        Mystring text = unit * repeats;
+        size_t bytes = text.get_length();
+        char *scratch = new char[bytes + 1];
+        
+        cout << "\n=== " << megabytes << " MB (" << bytes << " bytes) ===========================" << endl;
+        
+        report("lowercase, tolower per byte", bytes, time_us(reps, [&]() {
+            memcpy(scratch, text.get_str(), bytes);
+            to_lower_per_byte(scratch, bytes);
+        }));
+        report("lowercase, to_lower_chars", bytes, time_us(reps, [&]() {
+            to_lower_chars(scratch, text.get_str(), bytes);
+        }));
+        report("operator- (lowercase copy)", bytes, time_us(reps, [&]() {
+            Mystring lower = -text;
+            sink = sink + lower.get_length();
+        }));
+        report("operator++ (uppercase in place)", bytes, time_us(reps, [&]() {
+            ++text;
+        }));
+        
+        Mystring same = text;
+        Mystring other = text;
+        report("strcmp equal strings", bytes, time_us(reps, [&]() {
+            sink = sink + strcmp(text.get_str(), same.get_str());
+        }));
+        report("operator== equal strings", bytes, time_us(reps, [&]() {
+            sink = sink + (text == same);
+        }));
+        report("operator< equal strings", bytes, time_us(reps, [&]() {
+            sink = sink + (text < same);
+        }));
+        other += "!";
+        report("operator== different lengths", bytes, time_us(reps, [&]() {
+            sink = sink + (text == other);
+        }));
+        
+        // Check the kernels against the per-byte loop, including non-ASCII bytes
+        strcpy(scratch, text.get_str());
+        scratch[bytes / 2] = static_cast<char>(0xC9);
+        Mystring mixed {scratch};
+        to_lower_per_byte(scratch, bytes);
+        Mystring lowered = -mixed;
+        cout << "lowercase matches per-byte loop: " << boolalpha 
+             << (strcmp(scratch, lowered.get_str()) == 0) << endl;
+        
+        delete [] scratch;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    string part = (argc > 1) ? argv[1] : "all";
+    if (part == "all" || part == "ops")
+        operation_benchmarks();
+    if (part == "all" || part == "kernels")
+        kernel_benchmarks();
+    return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef _MYSTRING_REPEAT_H_
+#define _MYSTRING_REPEAT_H_
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+// Helpers for Mystring's repeat operators (operator* and operator*=). Both Task solutions
+// include this one copy from Mystring-common, so the fill and its size check live in one
+// place without either solution depending on the other.
+
+// Length of len chars repeated n times, 0 if n isn't positive.
+// Throws std::length_error if it is longer than a string can be - checked before
+// len * n is computed, so a large n can't wrap around to a short buffer.
+inline std::size_t repeat_length(std::size_t len, int n) {
+    if (n <= 0)
+        return 0;
+    constexpr std::size_t max_length = static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max()) / 2;
+    if (len > 0 && static_cast<std::size_t>(n) > max_length / len)
+        throw std::length_error {"Mystring repeat is too long"};
+    return len * static_cast<std::size_t>(n);
+}
+
+// Copies the first len chars of buff over the rest of buff until total chars are filled,
+// doubling the filled region with each memcpy so n repeats take O(log n) copies
+inline void repeat_fill(char *buff, std::size_t len, std::size_t total) {
+    std::size_t filled = len;
+    while (filled < total) {
+        std::size_t chunk = (filled < total - filled) ? filled : total - filled;
+        std::memcpy(buff + filled, buff, chunk);
+        filled += chunk;
+    }
+    buff[total] = '\0';
+}
+
+#endif // _MYSTRING_REPEAT_H_
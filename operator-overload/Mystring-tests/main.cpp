@@ -0,0 +1,324 @@
+// Mystring tests
+// Checks concatenation chains: the Mystring interface they share with Mystring, chains that
+// hold temporary operands, and comparisons between any mix of chains, Mystrings, views and
+// C-style strings - then repeats and their size check, copies of a sharing string detaching
+// when changed, strings in a fixed arena and moved between resources, the cached hash after
+// changes, operator>> against std::string's rules, and Mystring_view's split, find, substr,
+// starts_with and ends_with at the edges.
+// Build with -fsanitize=address to catch a chain outliving its operands.
+//
+// Build against the Task-Solution2 Mystring, e.g.
+//   g++ -std=c++17 -I../Task-Solution2 main.cpp ../Task-Solution2/Mystring.cpp ../Task-Solution2/Mystring_view.cpp ../Task-Solution2/Mystring_Kernels.cpp -o tests
+// ./tests prints every failed check and exits with 1 if there was one.
+#include <iostream>
+#include <functional>
+#include <iomanip>
+#include <memory_resource>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "../Mystring-common/Mystring_Repeat.h"
+
+static int failures {0};
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        std::cout << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// What f prints to std::cout
+template <typename Func>
+static std::string output_of(Func f) {
+    std::ostringstream out;
+    std::streambuf *old = std::cout.rdbuf(out.rdbuf());
+    f();
+    std::cout.rdbuf(old);
+    return out.str();
+}
+
+// A chain can be used where a Mystring is read
+static void test_chain_interface() {
+    Mystring a {"Larry"};
+    Mystring b {"Moe"};
+    check((a + b).get_length() == 8, "get_length of a chain");
+    check((a + " and " + b).get_length() == 13, "get_length of a longer chain");
+    check(output_of([&]() { (a + b).display(); }) == "LarryMoe : 8\n", "display of a chain");
+    
+    Mystring joined = a + b;
+    check(joined == "LarryMoe", "chain converted to a Mystring");
+    check(Mystring{a + "-" + b} == "Larry-Moe", "chain with a C-style string");
+}
+
+// Temporary Mystrings are moved into the chain, so a stored chain still has them
+static void test_chain_temporaries() {
+    Mystring a {"Larry"};
+    auto tail = a + Mystring{"Curly"};
+    auto both = Mystring{"Moe"} + Mystring{"Curly"};
+    auto longer = tail + Mystring{"!"} + both;
+    check(Mystring{tail} == "LarryCurly", "chain holding a temporary");
+    check(Mystring{both} == "MoeCurly", "chain holding two temporaries");
+    check(Mystring{longer} == "LarryCurly!MoeCurly", "chain of stored chains");
+    check(output_of([&]() { std::cout << longer; }) == "LarryCurly!MoeCurly", "chain written to a stream");
+    
+    Mystring s {"Moe"};
+    s = s + Mystring{"Moe"};
+    check(s == "MoeMoe", "assigning a chain that refers to the target");
+}
+
+// Chains compare with chains and with everything a view compares with, from either side
+static void test_chain_comparisons() {
+    Mystring a {"Larry"};
+    Mystring b {"Moe"};
+    check((a + b) == (a + b), "chain == chain");
+    check(!((a + b) == (b + a)), "chain == different chain");
+    check((a + b) != (b + a), "chain != chain");
+    check((a + b) < (b + a), "chain < chain");
+    check((b + a) > (a + b), "chain > chain");
+    check(!((a + b) < (a + b)) && !((a + b) > (a + b)), "equal chains are not ordered");
+    check((a + b + "!") == (a + (b + "!")), "chains nested differently");
+    check((a + Mystring{"Moe"}) == (Mystring{"Larry"} + b), "chains holding temporaries");
+    
+    Mystring larry_moe {"LarryMoe"};
+    check((a + b) == larry_moe && larry_moe == (a + b), "chain == Mystring");
+    check((a + b) == "LarryMoe" && "LarryMoe" == (a + b), "chain == C-style string");
+    check((a + b) != Mystring_view{"Larry"} && Mystring_view{"Larry"} != (a + b), "chain != view");
+    check((a + b) > a && a < (a + b), "chain ordered against a Mystring");
+}
+
+// A repeat too long for a string throws instead of wrapping around to a short buffer
+static void test_repeat() {
+    Mystring s {"Moe"};
+    check(Mystring_view{s * 3} == "MoeMoeMoe", "operator*");
+    check(Mystring_view{s * 0} == "" && Mystring_view{s * -2} == "", "operator* by 0 or less");
+    s *= 2;
+    check(Mystring_view{s} == "MoeMoe", "operator*=");
+    
+    bool thrown {false};
+    try {
+        repeat_length(std::size_t{1} << 40, 2147483647);
+    }
+    catch (const std::length_error &) {
+        thrown = true;
+    }
+    check(thrown, "repeat length overflow throws std::length_error");
+    check(repeat_length(0, 2147483647) == 0, "repeating an empty string");
+}
+
+// A copy of a sharing string shares its buffer until either of them is changed in place;
+// the one that changes gets its own buffer and the other keeps the old chars
+static void test_sharing_detach() {
+    Mystring original {"Larry"};
+    original.enable_sharing();
+    {
+        Mystring copy {original};
+        check(copy.get_str() == original.get_str() && original.use_count() == 2, "copy shares the buffer");
+        ++copy;
+        check(Mystring_view{copy} == "LARRY" && Mystring_view{original} == "Larry", "++ changes only the copy");
+        check(copy.get_str() != original.get_str() && original.use_count() == 1 && copy.use_count() == 1, "++ detaches");
+    }
+    {
+        Mystring copy {original};
+        copy *= 2;
+        check(Mystring_view{copy} == "LarryLarry" && Mystring_view{original} == "Larry", "*= changes only the copy");
+        check(original.use_count() == 1 && copy.use_count() == 1, "*= detaches");
+    }
+    {
+        Mystring copy;
+        copy = original;
+        check(original.use_count() == 2, "copy assignment shares the buffer");
+        copy += "!";
+        check(Mystring_view{copy} == "Larry!" && Mystring_view{original} == "Larry", "+= changes only the copy");
+        check(original.use_count() == 1 && copy.use_count() == 1, "+= detaches");
+    }
+    {
+        Mystring copy {original};
+        Mystring other {copy};
+        check(original.use_count() == 3, "copies of a copy share the buffer");
+        original += "?";
+        check(Mystring_view{original} == "Larry?" && Mystring_view{copy} == "Larry", "changing the original leaves the copies");
+        check(original.use_count() == 1 && copy.use_count() == 2, "the original detaches from its copies");
+    }
+    check(original.use_count() == 1, "use_count back to 1 once the copies are gone");
+}
+
+// Strings in a fixed arena, with nowhere to go once it is used up - anything that allocated
+// outside it would throw std::bad_alloc instead
+static void test_resources() {
+    char arena[1024];
+    std::pmr::monotonic_buffer_resource pool {arena, sizeof arena, std::pmr::null_memory_resource()};
+    auto in_arena = [&](const Mystring &s) { 
+        return !std::less<const char *>{}(s.get_str(), arena) && std::less<const char *>{}(s.get_str(), arena + sizeof arena); 
+    };
+    std::pmr::memory_resource *heap = std::pmr::get_default_resource();
+    
+    Mystring a {"Larry", &pool};
+    a += " and Moe";
+    check(a.get_resource() == &pool && in_arena(a) && Mystring_view{a} == "Larry and Moe", "string grown in the arena");
+    
+    Mystring copy {a};
+    check(copy.get_resource() == heap && !in_arena(copy) && Mystring_view{copy} == "Larry and Moe", "copy uses the default resource");
+    Mystring pooled {copy, &pool};
+    check(pooled.get_resource() == &pool && in_arena(pooled) && Mystring_view{pooled} == "Larry and Moe", "copy into a resource");
+    
+    a.enable_sharing();
+    Mystring shared {a, &pool};
+    Mystring unshared {a};
+    check(shared.get_str() == a.get_str() && unshared.get_str() != a.get_str() && a.use_count() == 2, 
+          "copies share a buffer only within its resource");
+    
+    // Move-assignment between resources copies into the target's resource; within one it steals the buffer
+    Mystring on_heap {"Curly"};
+    on_heap = std::move(pooled);
+    check(on_heap.get_resource() == heap && !in_arena(on_heap) && Mystring_view{on_heap} == "Larry and Moe", 
+          "move-assignment from the arena to the heap");
+    Mystring in_pool {"Moe", &pool};
+    in_pool = std::move(on_heap);
+    check(in_pool.get_resource() == &pool && in_arena(in_pool) && Mystring_view{in_pool} == "Larry and Moe",
+          "move-assignment from the heap into the arena");
+    const char *buffer = shared.get_str();
+    in_pool = std::move(shared);
+    check(in_pool.get_str() == buffer, "move-assignment within the arena steals the buffer");
+    
+    bool thrown {false};
+    try {
+        Mystring too_big {Mystring_view{arena, sizeof arena}, &pool};
+    }
+    catch (const std::bad_alloc &) {
+        thrown = true;
+    }
+    check(thrown, "a string that doesn't fit the arena throws std::bad_alloc");
+}
+
+// The hash is kept with the buffer: a change in place must clear it, and a sharing copy
+// reuses it until one of them changes
+static void test_hash_cache() {
+    auto view_hash = [](const char *s) { return Mystring_view{s}.hash(); };
+    Mystring s {"Larry"};
+    check(s.hash() == view_hash("Larry") && s.hash() == view_hash("Larry"), "hash equals the view's hash");
+    check(std::hash<Mystring>{}(s) == view_hash("Larry") && Mystring_hash{}("Larry") == s.hash(), "std::hash and Mystring_hash");
+    
+    const char *buffer = s.get_str();
+    ++s;
+    check(s.get_str() == buffer, "++ changes the chars in place");
+    check(s.hash() == view_hash("LARRY"), "hash after ++");
+    s *= 1;
+    s += "!";
+    check(s.hash() == view_hash("LARRY!"), "hash after +=");
+    s = Mystring{"Moe"};
+    check(s.hash() == view_hash("Moe"), "hash after assignment");
+    std::istringstream in {"Curly"};
+    in >> s;
+    check(s.hash() == view_hash("Curly"), "hash after operator>>");
+    
+    Mystring original {"Larry"};
+    original.enable_sharing();
+    std::size_t h = original.hash();
+    Mystring copy {original};
+    check(copy.hash() == h && copy.get_str() == original.get_str(), "sharing copy reuses the hash without detaching");
+    ++copy;
+    check(copy.hash() == view_hash("LARRY") && original.hash() == h, "detached copy hashes its own chars");
+}
+
+// operator>> reads like it does into a std::string
+static void test_extraction() {
+    Mystring s;
+    std::istringstream in {"  Larry\tMoe\n"};
+    in >> s;
+    check(Mystring_view{s} == "Larry" && in.good(), "first word");
+    in >> std::setw(2) >> s;
+    check(Mystring_view{s} == "Mo" && in.width() == 0, "width() truncates the word and is reset");
+    in >> s;
+    check(Mystring_view{s} == "e" && in.good(), "rest of the truncated word");
+    in >> s;
+    check(in.fail() && in.eof(), "failbit once the words run out");
+    
+    std::string long_word(100, 'x');
+    long_word[99] = 'y';
+    std::istringstream long_in {long_word + " Moe"};
+    long_in >> s;
+    check(Mystring_view{s} == Mystring_view{long_word.c_str()} && s.get_length() == 100, "word longer than the first allocation");
+    long_in >> s;
+    check(Mystring_view{s} == "Moe", "short word into the grown buffer");
+    
+    std::istringstream last {"Curly"};
+    last >> s;
+    check(Mystring_view{s} == "Curly" && last.eof() && !last.fail(), "eofbit without failbit on the last word");
+    
+    for (const char *text: {"", "  \n\t "}) {
+        std::istringstream empty {text};
+        empty >> s;
+        check(empty.fail() && empty.eof(), "failbit on a stream with no words");
+    }
+    
+    Mystring original {"Larry"};
+    original.enable_sharing();
+    Mystring copy {original};
+    std::istringstream word {"Moe"};
+    word >> copy;
+    check(Mystring_view{copy} == "Moe" && Mystring_view{original} == "Larry", "reading into a sharing copy detaches it");
+}
+
+// The fields of a split, copied out
+static std::vector<std::string> fields_of(Mystring_view view, char delim) {
+    std::vector<std::string> fields;
+    for (Mystring_view field: view.split(delim))
+        fields.emplace_back(field.data(), field.size());
+    return fields;
+}
+
+// Empty fields are kept - before, between and after delimiters
+static void test_view_split() {
+    check(fields_of("a,,b,", ',') == std::vector<std::string>{"a", "", "b", ""}, "split with empty fields");
+    check(fields_of("", ',') == std::vector<std::string>{""}, "split of an empty view");
+    check(fields_of(",", ',') == std::vector<std::string>{"", ""}, "split of a lone delimiter");
+    check(fields_of("Larry", ',') == std::vector<std::string>{"Larry"}, "split with no delimiter");
+}
+
+static void test_view_search() {
+    Mystring_view v {"Larry,Moe"};
+    check(v.find("Moe") == 6 && v.find('r') == 2, "find");
+    check(v.find("r", 3) == 3 && v.find('r', 4) == Mystring_view::npos, "find from a position");
+    check(v.find("Moe!") == Mystring_view::npos && v.find("Moe", 7) == Mystring_view::npos, "find with no match");
+    check(v.find("", 9) == 9 && v.find("", 10) == Mystring_view::npos, "find the empty needle up to the end");
+    check(v.find("M", 10) == Mystring_view::npos && v.find('M', 100) == Mystring_view::npos, "find past the end");
+    
+    check(v.substr(6) == "Moe" && v.substr(0, 5) == "Larry" && v.substr(6, 100) == "Moe", "substr");
+    check(v.substr(9).empty(), "substr at the end");
+    bool thrown {false};
+    try {
+        v.substr(10);
+    }
+    catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    check(thrown, "substr past the end throws std::out_of_range");
+    
+    check(v.starts_with("Larry") && v.starts_with("") && v.starts_with(v), "starts_with");
+    check(!v.starts_with("Moe") && !v.starts_with("Larry,Moe!"), "not starts_with");
+    check(v.ends_with("Moe") && v.ends_with("") && v.ends_with(v), "ends_with");
+    check(!v.ends_with("Larry") && !v.ends_with("!Larry,Moe"), "not ends_with");
+}
+
+int main() {
+    test_chain_interface();
+    test_chain_temporaries();
+    test_chain_comparisons();
+    test_repeat();
+    test_sharing_detach();
+    test_resources();
+    test_hash_cache();
+    test_extraction();
+    test_view_split();
+    test_view_search();
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}
@@ -1,30 +1,39 @@
 #include <iostream>
 #include <cstring>
 #include "Mystring.h"
+#include "../Mystring-common/Mystring_Repeat.h"
 
  // No-args constructor
 Mystring::Mystring() 
-    : str{nullptr} {
+    : str{nullptr}, length{0}, capacity{0} {
     str = new char[1];
     *str = '\0';
 }
 
 // Overloaded constructor
 Mystring::Mystring(const char *s) 
-    : str {nullptr} {
+    : str {nullptr}, length{0}, capacity{0} {
         if (s==nullptr) {
             str = new char[1];
             *str = '\0';
         } else {
-            str = new char[strlen(s)+1];
+            length = capacity = strlen(s);
+            str = new char[capacity+1];
             strcpy(str, s);
         }
 }
 
+// Capacity constructor - empty string with room for capacity chars
+Mystring::Mystring(std::size_t capacity) 
+    : str{nullptr}, length{0}, capacity{capacity} {
+    str = new char[capacity + 1];
+    *str = '\0';
+}
+
 // Copy constructor
 Mystring::Mystring(const Mystring &source) 
-    : str{nullptr} {
-        str = new char[strlen(source.str)+ 1];
+    : str{nullptr}, length{source.length}, capacity{source.length} {
+        str = new char[length + 1];
         strcpy(str, source.str);
  //       std::cout << "Copy constructor used" << std::endl;
 
@@ -32,8 +41,9 @@ Mystring::Mystring(const Mystring &source)
 
 // Move constructor
 Mystring::Mystring( Mystring &&source) 
-    :str(source.str) {
+    :str(source.str), length{source.length}, capacity{source.capacity} {
         source.str = nullptr;
+        source.length = source.capacity = 0;
 //        std::cout << "Move constructor used" << std::endl;
 }
 
@@ -49,7 +59,8 @@ Mystring &Mystring::operator=(const Mystring &rhs) {
     if (this == &rhs) 
         return *this;
     delete [] str;
-    str = new char[strlen(rhs.str) + 1];
+    length = capacity = rhs.length;
+    str = new char[length + 1];
     strcpy(str, rhs.str);
     return *this;
 }
@@ -61,18 +72,32 @@ Mystring &Mystring::operator=( Mystring &&rhs) {
         return *this;
     delete [] str;
     str = rhs.str;
+    length = rhs.length;
+    capacity = rhs.capacity;
     rhs.str = nullptr;
+    rhs.length = rhs.capacity = 0;
     return *this;
 }
 
 
+// Grow the buffer to hold new_capacity chars, keeping the current contents
+void Mystring::reserve(std::size_t new_capacity) {
+    if (new_capacity <= capacity)
+        return;
+    char *buff = new char[new_capacity + 1];
+    std::memcpy(buff, str, length + 1);
+    delete [] str;
+    str = buff;
+    capacity = new_capacity;
+}
+
 // Display method
 void Mystring::display() const {
     std::cout << str << " : " << get_length() << std::endl;
 }
 
  // getters
- int Mystring::get_length() const { return strlen(str); }
+ int Mystring::get_length() const { return length; }
  const char *Mystring::get_str() const { return str; }
 
 // overloaded insertion operator
@@ -138,27 +163,25 @@ Mystring &Mystring::operator+=(const Mystring &rhs)  {
     return *this;
 }
 
-// repeat
+// repeat - allocates the final size once and fills it by doubling
 Mystring Mystring::operator*(int n) const {
-    Mystring temp;
-    for (int i=1; i<= n; i++)
-        temp = temp + *this;
-    return temp;
-    /*
-    size_t buff_size = std::strlen(str) * n + 1;
-    char *buff = new char[buff_size];
-    strcpy(buff, "");
-    for (int i =1; i <=n; i++)
-        strcat(buff, str);
-    Mystring temp{buff};
-    delete [] buff;
+    if (n <= 0)
+        return Mystring{};
+    std::size_t total = repeat_length(length, n);
+    Mystring temp {total};
+    std::memcpy(temp.str, str, length);
+    repeat_fill(temp.str, length, total);
+    temp.length = total;
     return temp;
-    */
 }
 
-// repeat and assign
+// repeat and assign - repeats in place when the buffer is big enough
 Mystring &Mystring::operator*=(int n) {
-    *this = *this * n;
+    std::size_t total = repeat_length(length, n);
+    if (total > capacity)
+        reserve(total);
+    repeat_fill(str, length, total);
+    length = total;
     return *this;
 }                             
 
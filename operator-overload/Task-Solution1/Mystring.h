@@ -1,5 +1,6 @@
 #ifndef _MYSTRING_H_
 #define _MYSTRING_H_
+#include <cstddef>
 
 class Mystring
 {
@@ -8,6 +9,11 @@ class Mystring
 
 private:
     char *str;      // pointer to a char[] that holds a C-style string
+    std::size_t length;         // number of chars before the '\0'
+    std::size_t capacity;      // number of chars str can hold before the '\0'
+
+    explicit Mystring(std::size_t capacity);         // empty string with room for capacity chars
+    void reserve(std::size_t new_capacity);         // grow the buffer, keeping the contents
 public:
     Mystring();                                                         // No-args constructor
     Mystring(const char *s);                                     // Overloaded constructor
@@ -1,70 +1,238 @@
 #include <iostream>
 #include <cstring>
+#include <atomic>
+#include <new>
+#include <memory_resource>
 #include "Mystring.h"
+#include "Mystring_Kernels.h"
+#include "../Mystring-common/Mystring_Repeat.h"
+
+#ifdef MYSTRING_TRACE
+#define MYSTRING_TRACE_COUNT(counter) (++Mystring_trace::counter)
+#else
+#define MYSTRING_TRACE_COUNT(counter)
+#endif
+
+// Every buffer starts with a header, followed by the chars str points at.
+// The header remembers where the buffer came from so it can be handed back there;
+// the reference count is only ever above 1 for strings that have sharing enabled.
+struct Buffer_header {
+    std::atomic<long> refs;
+    std::pmr::memory_resource *resource;
+    std::size_t bytes;
+    std::atomic<std::size_t> hash;          // hash of the chars, 0 until someone asks for it
+};
+
+static Buffer_header *header_of(char *str) {
+    return reinterpret_cast<Buffer_header *>(str - sizeof(Buffer_header));
+}
+
+// Allocate a buffer for capacity chars plus the '\0' from resource, with a reference count of 1
+char *Mystring::allocate(std::size_t capacity, std::pmr::memory_resource *resource) {
+    std::size_t bytes = sizeof(Buffer_header) + capacity + 1;
+    char *raw = static_cast<char *>(resource->allocate(bytes, alignof(Buffer_header)));
+    new (raw) Buffer_header {{1}, resource, bytes, {0}};
+    return raw + sizeof(Buffer_header);
+}
+
+// Drop one reference to a buffer, returning it to its resource with the last one
+void Mystring::release(char *str) {
+    if (str == nullptr)
+        return;
+    Buffer_header *header = header_of(str);
+    if (header->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::pmr::memory_resource *resource = header->resource;
+        std::size_t bytes = header->bytes;
+        header->~Buffer_header();
+        resource->deallocate(header, bytes, alignof(Buffer_header));
+    }
+}
 
  // No-args constructor
 Mystring::Mystring() 
-    : str{nullptr} {
-    str = new char[1];
+    : str{nullptr}, length{0}, capacity{0}, sharing{false}, resource{std::pmr::get_default_resource()} {
+    str = allocate(0, resource);
     *str = '\0';
 }
 
 // Overloaded constructor
-Mystring::Mystring(const char *s) 
-    : str {nullptr} {
+Mystring::Mystring(const char *s, std::pmr::memory_resource *resource) 
+    : str {nullptr}, length{0}, capacity{0}, sharing{false}, resource{resource} {
         if (s==nullptr) {
-            str = new char[1];
+            str = allocate(0, resource);
             *str = '\0';
         } else {
-            str = new char[strlen(s)+1];
+            length = capacity = strlen(s);
+            str = allocate(capacity, resource);
             strcpy(str, s);
         }
 }
 
-// Copy constructor
+// View constructor
+Mystring::Mystring(Mystring_view view, std::pmr::memory_resource *resource) 
+    : str{nullptr}, length{view.size()}, capacity{view.size()}, sharing{false}, resource{resource} {
+        str = allocate(capacity, resource);
+        view.copy_to(str);
+        str[length] = '\0';
+}
+
+// Capacity constructor - empty string with room for capacity chars
+Mystring::Mystring(std::size_t capacity, std::pmr::memory_resource *resource) 
+    : str{nullptr}, length{0}, capacity{capacity}, sharing{false}, resource{resource} {
+    str = allocate(capacity, resource);
+    *str = '\0';
+}
+
+// Copy constructor - the copy uses the default resource, like a std::pmr::string copy
 Mystring::Mystring(const Mystring &source) 
-    : str{nullptr} {
-        str = new char[strlen(source.str)+ 1];
-        strcpy(str, source.str);
- //       std::cout << "Copy constructor used" << std::endl;
+    : Mystring{source, std::pmr::get_default_resource()} {
+}
 
+// Copy constructor with a resource - shares the source's buffer if the source 
+// has sharing enabled and its buffer came from the same resource
+Mystring::Mystring(const Mystring &source, std::pmr::memory_resource *resource) 
+    : str{nullptr}, length{source.length}, capacity{source.length}, sharing{source.sharing}, resource{resource} {
+        MYSTRING_TRACE_COUNT(copy_constructs);
+        if (sharing && source.str != nullptr && source.resource == resource) {
+            MYSTRING_TRACE_COUNT(shared_copies);
+            str = source.str;
+            capacity = source.capacity;
+            header_of(str)->refs.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            str = allocate(length, resource);
+            std::memcpy(str, source.str, length + 1);
+        }
 }
 
-// Move constructor
-Mystring::Mystring( Mystring &&source) 
-    :str(source.str) {
+// Move constructor - the buffer moves along with its resource
+Mystring::Mystring( Mystring &&source) noexcept
+    :str(source.str), length{source.length}, capacity{source.capacity}, sharing{source.sharing}, resource{source.resource} {
         source.str = nullptr;
-//        std::cout << "Move constructor used" << std::endl;
+        source.length = source.capacity = 0;
+        MYSTRING_TRACE_COUNT(move_constructs);
 }
 
  // Destructor
 Mystring::~Mystring() {
-    delete [] str;
+    release(str);
 }
 
- // Copy assignment
+ // Copy assignment - this string keeps its own resource
 Mystring &Mystring::operator=(const Mystring &rhs) {
-//    std::cout << "Using copy assignment" << std::endl;
-
+    MYSTRING_TRACE_COUNT(copy_assigns);
     if (this == &rhs) 
         return *this;
-    delete [] str;
-    str = new char[strlen(rhs.str) + 1];
-    strcpy(str, rhs.str);
+    if (rhs.sharing && rhs.str != nullptr && rhs.resource == resource) {
+        MYSTRING_TRACE_COUNT(shared_copies);
+        header_of(rhs.str)->refs.fetch_add(1, std::memory_order_relaxed);
+        release(str);
+        str = rhs.str;
+        length = rhs.length;
+        capacity = rhs.capacity;
+    } else {
+        assign(rhs);
+    }
+    sharing = rhs.sharing;
     return *this;
 }
 
-// Move assignment
+// Move assignment - steals rhs's buffer if it came from the same resource, otherwise copies it
 Mystring &Mystring::operator=( Mystring &&rhs) {
- //   std::cout << "Using move assignment" << std::endl;
+    MYSTRING_TRACE_COUNT(move_assigns);
     if (this == &rhs) 
         return *this;
-    delete [] str;
+    if (rhs.resource != resource) {
+        assign(rhs);
+        sharing = rhs.sharing;
+        return *this;
+    }
+    release(str);
     str = rhs.str;
+    length = rhs.length;
+    capacity = rhs.capacity;
+    sharing = rhs.sharing;
     rhs.str = nullptr;
+    rhs.length = rhs.capacity = 0;
+    return *this;
+}
+
+// true if other strings are using this string's buffer too
+bool Mystring::buffer_shared() const {
+    return str != nullptr && header_of(str)->refs.load(std::memory_order_acquire) > 1;
+}
+
+// Make sure this string has a buffer of its own that can hold new_capacity chars,
+// copying the current contents into a new buffer if it doesn't.
+// Every operator that modifies the chars in place calls this first.
+void Mystring::reserve(std::size_t new_capacity) {
+    if (str != nullptr && new_capacity <= capacity && !buffer_shared()) {
+        forget_hash();
+        return;
+    }
+    if (new_capacity < length)
+        new_capacity = length;
+    char *buff = allocate(new_capacity, resource);
+    if (length > 0)
+        std::memcpy(buff, str, length);
+    buff[length] = '\0';
+    release(str);
+    str = buff;
+    capacity = new_capacity;
+}
+
+// Replace the contents with the chars of view, reusing the buffer when it is ours and big enough.
+// view may point into this string's own buffer.
+void Mystring::assign(Mystring_view view) {
+    if (str != nullptr && view.size() <= capacity && !buffer_shared()) {
+        forget_hash();
+        std::memmove(str, view.data(), view.size());
+    } else {
+        char *buff = allocate(view.size(), resource);
+        view.copy_to(buff);
+        release(str);
+        str = buff;
+        capacity = view.size();
+    }
+    length = view.size();
+    str[length] = '\0';
+}
+
+// Copies made from this string from now on share its buffer instead of allocating
+// their own; whichever copy is modified first gets its own buffer at that point
+Mystring &Mystring::enable_sharing() {
+    sharing = true;
     return *this;
 }
 
+// Clear the cached hash before the chars are changed in place
+void Mystring::forget_hash() {
+    if (str != nullptr)
+        header_of(str)->hash.store(0, std::memory_order_relaxed);
+}
+
+// Hash of the chars - computed on first use and kept in the buffer header, so copies
+// sharing the buffer reuse it. Anything that changes the chars in place clears it.
+std::size_t Mystring::hash() const {
+    if (str == nullptr)
+        return hash_chars("", 0);
+    std::atomic<std::size_t> &cached = header_of(str)->hash;
+    std::size_t h = cached.load(std::memory_order_relaxed);
+    if (h == 0) {
+        h = hash_chars(str, length);
+        cached.store(h, std::memory_order_relaxed);
+    }
+    return h;
+}
+
+// Where this string's buffers are allocated from
+std::pmr::memory_resource *Mystring::get_resource() const {
+    return resource;
+}
+
+// Number of strings using this string's buffer (1 unless sharing is enabled)
+long Mystring::use_count() const {
+    return (str == nullptr) ? 0 : header_of(str)->refs.load(std::memory_order_acquire);
+}
 
 // Display method
 void Mystring::display() const {
@@ -72,7 +240,7 @@ void Mystring::display() const {
 }
 
  // getters
- int Mystring::get_length() const { return strlen(str); }
+ int Mystring::get_length() const { return length; }
  const char *Mystring::get_str() const { return str; }
 
 // overloaded insertion operator
@@ -82,79 +250,84 @@ std::ostream &operator<<(std::ostream &os, const Mystring &rhs) {
 }
 
 // overloaded extraction operator
+// Reads the next whitespace-delimited word straight from the stream buffer into rhs,
+// reusing rhs's existing buffer and only growing it (geometrically) when the word doesn't fit
 std::istream &operator>>(std::istream &in, Mystring &rhs) {
-    char *buff = new char[1000];
-    in >> buff;
-    rhs = Mystring{buff};
-    delete [] buff;
+    using traits = std::istream::traits_type;
+    std::istream::sentry sentry {in};       // skips leading whitespace
+    if (!sentry)
+        return in;
+    
+    const std::ctype<char> &ct = std::use_facet<std::ctype<char>>(in.getloc());
+    std::streambuf *sb = in.rdbuf();
+    std::size_t max_chars = (in.width() > 0) ? static_cast<std::size_t>(in.width()) : static_cast<std::size_t>(-1);
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    
+    rhs.length = 0;
+    rhs.reserve((rhs.capacity > Mystring::def_capacity) ? rhs.capacity : Mystring::def_capacity);
+    
+    traits::int_type c = sb->sgetc();
+    while (rhs.length < max_chars) {
+        if (traits::eq_int_type(c, traits::eof())) {
+            state |= std::ios_base::eofbit;
+            break;
+        }
+        char ch = traits::to_char_type(c);
+        if (ct.is(std::ctype_base::space, ch))
+            break;
+        if (rhs.length == rhs.capacity)
+            rhs.reserve(rhs.capacity * 2);
+        rhs.str[rhs.length++] = ch;
+        c = sb->snextc();
+    }
+    rhs.str[rhs.length] = '\0';
+    in.width(0);
+    
+    if (rhs.length == 0)
+        state |= std::ios_base::failbit;
+    in.setstate(state);
     return in;
 }
 
-// Equality
-bool operator==(const Mystring &lhs, const Mystring &rhs) {
-    return (std::strcmp(lhs.str, rhs.str) == 0);
-}
-
-// Not equals
-bool operator!=(const Mystring &lhs, const Mystring &rhs) {
-    return !(std::strcmp(lhs.str, rhs.str) == 0);
-}
-
-// Less than
-bool operator<(const Mystring &lhs, const Mystring &rhs) {
-    return (std::strcmp(lhs.str, rhs.str) < 0);
-}
-
-// Greater than
-bool operator>(const Mystring &lhs, const Mystring &rhs) {
-    return (std::strcmp(lhs.str, rhs.str) > 0);
-}
-
 // Make lowercase
 Mystring operator-(const Mystring &obj) {
-    char *buff = new char[std::strlen(obj.str) + 1];
-    std::strcpy(buff, obj.str);
-    for (size_t i=0; i<std::strlen(buff); i++) 
-        buff[i] = std::tolower(buff[i]);
-    Mystring temp {buff};
-    delete [] buff;
-    return temp;
-}
-
-// Concatenation
-Mystring operator+(const Mystring &lhs, const Mystring &rhs) {
-    char *buff = new char[std::strlen(lhs.str) + std::strlen(rhs.str) + 1];
-    std::strcpy(buff, lhs.str);
-    std::strcat(buff, rhs.str);
-    Mystring temp {buff};
-    delete [] buff;
+    Mystring temp {obj.length};
+    to_lower_chars(temp.str, obj.str, obj.length);
+    temp.str[obj.length] = '\0';
+    temp.length = obj.length;
     return temp;
 }
 
-// concat and assign
-Mystring &operator+=( Mystring &lhs, const Mystring &rhs) {
-     lhs =  lhs + rhs;
-     return lhs;
+// concat and assign - appends in place when the buffer has room
+Mystring &operator+=( Mystring &lhs, Mystring_view rhs) {
+     return lhs.append(rhs);
 }
 
-// Repeat
+// Repeat - allocates the final size once and fills it by doubling
  Mystring operator*(const Mystring &lhs, int n)  {
-    Mystring temp;
-    for (int i=1; i<= n; i++)
-        temp = temp + lhs;
+    if (n <= 0)
+        return Mystring{};
+    std::size_t total = repeat_length(lhs.length, n);
+    Mystring temp {total};
+    std::memcpy(temp.str, lhs.str, lhs.length);
+    repeat_fill(temp.str, lhs.length, total);
+    temp.length = total;
     return temp;
 }
         
-// Repeat and assign
+// Repeat and assign - repeats in place when the buffer is big enough
  Mystring &operator*=( Mystring &lhs, int n) {
-        lhs = lhs * n;
+        std::size_t total = repeat_length(lhs.length, n);
+        lhs.reserve(total);
+        repeat_fill(lhs.str, lhs.length, total);
+        lhs.length = total;
         return lhs;
 }
 
 // Make uppercase - pre increment
 Mystring &operator++(Mystring &obj) {
-    for (size_t i=0; i< std::strlen(obj.str); i++)
-        obj.str[i] = std::toupper(obj.str[i]);
+    obj.reserve(obj.length);
+    to_upper_chars(obj.str, obj.str, obj.length);
     return obj;
 }
 
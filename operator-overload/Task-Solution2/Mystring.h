@@ -1,15 +1,37 @@
 #ifndef _MYSTRING_H_
 #define _MYSTRING_H_
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory_resource>      // C++17
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include "Mystring_view.h"
+
+template <typename Lhs, typename Rhs>
+class Mystring_concat;
+
+#ifdef MYSTRING_TRACE
+// Counts of copies and moves, kept when every file is built with -DMYSTRING_TRACE
+// (see operator-overload/Mystring-benchmark)
+struct Mystring_trace {
+    inline static long copy_constructs {0};
+    inline static long move_constructs {0};
+    inline static long copy_assigns {0};
+    inline static long move_assigns {0};
+    inline static long shared_copies {0};        // copies that shared a buffer instead of allocating
+    
+    static void reset() { copy_constructs = move_constructs = copy_assigns = move_assigns = shared_copies = 0; }
+};
+#endif
 
 class Mystring
 {
     friend Mystring operator-(const Mystring &obj);                                        // make lowercase
-    friend Mystring operator+(const Mystring &lhs, const Mystring &rhs);       // concatenate
-    friend bool operator==(const Mystring &lhs, const Mystring &rhs);           // equals
-    friend bool operator!=(const Mystring &lhs, const Mystring &rhs) ;           // not equals
-    friend bool operator<(const Mystring &lhs, const Mystring &rhs) ;            // less than
-    friend bool operator>(const Mystring &lhs, const Mystring &rhs) ;            // greater than
-    friend Mystring &operator+=( Mystring &lhs, const Mystring &rhs);          // s1 += s2;  concat and assign
+    friend Mystring &operator+=( Mystring &lhs, Mystring_view rhs);              // s1 += s2;  concat and assign
+    template <typename Lhs, typename Rhs>
+    friend Mystring &operator+=( Mystring &lhs, const Mystring_concat<Lhs, Rhs> &rhs);    // s1 += s2 + s3;
     friend Mystring operator*(const Mystring &lhs, int n) ;                               // s1 = s2 * 3;  repeat s2 n times
     friend Mystring &operator*=( Mystring &lhs, int n);                                   // s1 *= 3;   s1 = s1 * 3;    
     friend Mystring &operator++(Mystring &obj);                                           // ++s1; pre-increment make uppercase
@@ -19,20 +41,253 @@ class Mystring
 
 private:
     char *str;      // pointer to a char[] that holds a C-style string
+    std::size_t length;         // number of chars before the '\0'
+    std::size_t capacity;      // number of chars str can hold before the '\0'
+    bool sharing;                  // copies share this string's buffer until modified
+    std::pmr::memory_resource *resource;     // where this string's buffers are allocated from
+    static constexpr std::size_t def_capacity = 15;     // first allocation when an empty string starts growing
+
+    explicit Mystring(std::size_t capacity,
+                      std::pmr::memory_resource *resource = std::pmr::get_default_resource());   // empty string with room for capacity chars
+    static char *allocate(std::size_t capacity, std::pmr::memory_resource *resource);    // reference-counted buffer for capacity chars
+    static void release(char *str);                   // drop a reference to a buffer
+    bool buffer_shared() const;                           // other strings use this buffer too
+    void reserve(std::size_t new_capacity);         // own the buffer and grow it, keeping the contents
+    void assign(Mystring_view view);                // replace the contents, reusing the buffer if possible
+    void forget_hash();                                     // the chars are about to change in place
+    template <typename Expr>
+    Mystring &append(const Expr &expr);              // append a piece or concatenation in place
 public:
+    // Every constructor that builds new contents can be given a std::pmr::memory_resource
+    // (e.g. a std::pmr::monotonic_buffer_resource per request) to allocate from instead of the
+    // default resource. Copies and operator results use the default resource unless one is given,
+    // so they can safely outlive an arena; strings in an arena must be destroyed before it.
     Mystring();                                                        // No-args constructor
-    Mystring(const char *s);                                     // Overloaded constructor
+    Mystring(const char *s,
+             std::pmr::memory_resource *resource = std::pmr::get_default_resource());     // Overloaded constructor
+    explicit Mystring(Mystring_view view,
+                      std::pmr::memory_resource *resource = std::pmr::get_default_resource());    // copy the chars of a view
+    template <typename Lhs, typename Rhs>
+    Mystring(const Mystring_concat<Lhs, Rhs> &expr,
+             std::pmr::memory_resource *resource = std::pmr::get_default_resource());     // Concatenation constructor - one allocation for a whole chain
     Mystring(const Mystring &source);                    // Copy constructor
-    Mystring( Mystring &&source);                         // Move constructor
+    Mystring(const Mystring &source, std::pmr::memory_resource *resource);      // Copy constructor into resource
+    Mystring( Mystring &&source) noexcept;             // Move constructor
     ~Mystring();                                                      // Destructor
     
     Mystring &operator=(const Mystring &rhs);     // Copy assignment
     Mystring &operator=(Mystring &&rhs);           // Move assignment
+    template <typename Lhs, typename Rhs>
+    Mystring &operator=(const Mystring_concat<Lhs, Rhs> &expr);    // Concatenation assignment - built in this string's resource
+    
+    std::pmr::memory_resource *get_resource() const;
+
+    Mystring &enable_sharing();                         // copies share this buffer until one is modified
+    long use_count() const;                                   // strings using this buffer
+    
+    std::size_t hash() const;                               // computed once, then kept with the buffer
     
     void display() const;
     
     int get_length() const;                                      // getters
     const char *get_str() const;
+    
+    operator Mystring_view() const;                       // view of the whole string
 };
 
+inline Mystring::operator Mystring_view() const {
+    return Mystring_view{str, length};
+}
+
+// Concatenation
+//
+// s1 + s2 + "abc" + s3 doesn't build a Mystring per +. Each + returns a small Mystring_concat
+// node that holds views of its operands; the whole chain is sized once and copied into a
+// single allocation when it is converted to a Mystring (assigned, constructed or passed as one).
+// A chain converts to a Mystring implicitly and has the read-only Mystring interface that
+// doesn't need the chars in one place - get_length() and display(); build a Mystring for get_str().
+//
+// Temporary Mystrings, e.g. s1 + Mystring{"abc"}, are moved into the chain rather than viewed,
+// so auto s = s1 + Mystring{"abc"}; is safe. Other operands are only viewed - a stored chain
+// must not outlive the strings it was built from, just like a Mystring_view.
+
+template <typename Lhs, typename Rhs>
+class Mystring_concat {
+private:
+    Lhs lhs;
+    Rhs rhs;
+    std::size_t length;
+public:
+    Mystring_concat(Lhs lhs, Rhs rhs) 
+        : lhs{std::move(lhs)}, rhs{std::move(rhs)}, length{this->lhs.size() + this->rhs.size()} {}
+    
+    int get_length() const { return static_cast<int>(length); }
+    void display() const { Mystring{*this}.display(); }
+    
+    std::size_t size() const { return length; }
+    char *copy_to(char *dest) const { return rhs.copy_to(lhs.copy_to(dest)); }
+    void write_to(std::ostream &os) const { 
+        lhs.write_to(os); 
+        rhs.write_to(os); 
+    }
+};
+
+// A temporary Mystring operand, moved into the chain so it lives as long as the chain does
+class Mystring_temporary {
+private:
+    Mystring s;
+public:
+    explicit Mystring_temporary(Mystring s) 
+        : s{std::move(s)} {}
+    
+    std::size_t size() const { return Mystring_view(s).size(); }
+    char *copy_to(char *dest) const { return Mystring_view(s).copy_to(dest); }
+    void write_to(std::ostream &os) const { Mystring_view(s).write_to(os); }
+};
+
+// What each kind of + operand is held as inside a chain
+template <typename T>
+struct Mystring_operand {};
+template <>
+struct Mystring_operand<Mystring> { using type = Mystring_view; };
+template <>
+struct Mystring_operand<Mystring_view> { using type = Mystring_view; };
+template <>
+struct Mystring_operand<const char *> { using type = Mystring_view; };
+template <>
+struct Mystring_operand<char *> { using type = Mystring_view; };
+template <typename Lhs, typename Rhs>
+struct Mystring_operand<Mystring_concat<Lhs, Rhs>> { using type = Mystring_concat<Lhs, Rhs>; };
+
+// T as deduced by a forwarding reference - a Mystring rvalue is the only type left without a reference
+template <typename T>
+using Mystring_held = typename std::conditional<
+    std::is_same<typename std::remove_cv<T>::type, Mystring>::value,
+    Mystring_temporary,
+    typename Mystring_operand<typename std::decay<T>::type>::type>::type;
+
+// Concatenate - any mix of Mystrings, views, C-style strings and other concatenations
+template <typename Lhs, typename Rhs,
+          typename L = Mystring_held<Lhs>,
+          typename R = Mystring_held<Rhs>>
+Mystring_concat<L, R> operator+(Lhs &&lhs, Rhs &&rhs) {
+    return Mystring_concat<L, R>{L(std::forward<Lhs>(lhs)), R(std::forward<Rhs>(rhs))};
+}
+
+template <typename Lhs, typename Rhs>
+std::ostream &operator<<(std::ostream &os, const Mystring_concat<Lhs, Rhs> &rhs) {
+    rhs.write_to(os);
+    return os;
+}
+
+// Concatenation constructor
+template <typename Lhs, typename Rhs>
+Mystring::Mystring(const Mystring_concat<Lhs, Rhs> &expr, std::pmr::memory_resource *resource) 
+    : str{nullptr}, length{expr.size()}, capacity{expr.size()}, sharing{false}, resource{resource} {
+        str = allocate(capacity, resource);
+        expr.copy_to(str);
+        str[length] = '\0';
+}
+
+// Concatenation assignment - expr may refer to this string, so it is always built
+// into a new buffer before the old one is released
+template <typename Lhs, typename Rhs>
+Mystring &Mystring::operator=(const Mystring_concat<Lhs, Rhs> &expr) {
+    std::size_t new_length = expr.size();
+    char *buff = allocate(new_length, resource);
+    expr.copy_to(buff);
+    buff[new_length] = '\0';
+    release(str);
+    str = buff;
+    length = capacity = new_length;
+    return *this;
+}
+
+// Append in place, growing geometrically so repeated += stays linear.
+// A shared buffer is never written to - the string moves to a buffer of its own first.
+// expr may refer to this string, so it is copied before the old buffer is released.
+template <typename Expr>
+Mystring &Mystring::append(const Expr &expr) {
+    std::size_t new_length = length + expr.size();
+    if (new_length > capacity || str == nullptr || buffer_shared()) {
+        std::size_t new_capacity = (new_length > capacity * 2) ? new_length : capacity * 2;
+        char *buff = allocate(new_capacity, resource);
+        if (length > 0)
+            std::memcpy(buff, str, length);
+        expr.copy_to(buff + length);
+        release(str);
+        str = buff;
+        capacity = new_capacity;
+    } else {
+        forget_hash();
+        expr.copy_to(str + length);
+    }
+    length = new_length;
+    str[length] = '\0';
+    return *this;
+}
+
+// concat and assign
+template <typename Lhs, typename Rhs>
+Mystring &operator+=( Mystring &lhs, const Mystring_concat<Lhs, Rhs> &rhs) {
+    return lhs.append(rhs);
+}
+
+// The other operators take a Mystring; declaring them here lets a concatenation
+// convert to one, e.g. -(s1 + s2) or (s1 + s2) * 3
+Mystring operator-(const Mystring &obj);
+Mystring operator*(const Mystring &lhs, int n);
+
+// A concatenation is built into a Mystring before it is compared - with a view, a Mystring,
+// a C-style string or another concatenation
+template <typename Lhs, typename Rhs>
+bool operator==(const Mystring_concat<Lhs, Rhs> &lhs, Mystring_view rhs) { return Mystring{lhs} == rhs; }
+template <typename Lhs, typename Rhs>
+bool operator==(Mystring_view lhs, const Mystring_concat<Lhs, Rhs> &rhs) { return lhs == Mystring{rhs}; }
+template <typename Lhs, typename Rhs>
+bool operator!=(const Mystring_concat<Lhs, Rhs> &lhs, Mystring_view rhs) { return Mystring{lhs} != rhs; }
+template <typename Lhs, typename Rhs>
+bool operator!=(Mystring_view lhs, const Mystring_concat<Lhs, Rhs> &rhs) { return lhs != Mystring{rhs}; }
+template <typename Lhs, typename Rhs>
+bool operator<(const Mystring_concat<Lhs, Rhs> &lhs, Mystring_view rhs) { return Mystring{lhs} < rhs; }
+template <typename Lhs, typename Rhs>
+bool operator<(Mystring_view lhs, const Mystring_concat<Lhs, Rhs> &rhs) { return lhs < Mystring{rhs}; }
+template <typename Lhs, typename Rhs>
+bool operator>(const Mystring_concat<Lhs, Rhs> &lhs, Mystring_view rhs) { return Mystring{lhs} > rhs; }
+template <typename Lhs, typename Rhs>
+bool operator>(Mystring_view lhs, const Mystring_concat<Lhs, Rhs> &rhs) { return lhs > Mystring{rhs}; }
+template <typename L1, typename R1, typename L2, typename R2>
+bool operator==(const Mystring_concat<L1, R1> &lhs, const Mystring_concat<L2, R2> &rhs) { return Mystring{lhs} == Mystring{rhs}; }
+template <typename L1, typename R1, typename L2, typename R2>
+bool operator!=(const Mystring_concat<L1, R1> &lhs, const Mystring_concat<L2, R2> &rhs) { return Mystring{lhs} != Mystring{rhs}; }
+template <typename L1, typename R1, typename L2, typename R2>
+bool operator<(const Mystring_concat<L1, R1> &lhs, const Mystring_concat<L2, R2> &rhs) { return Mystring{lhs} < Mystring{rhs}; }
+template <typename L1, typename R1, typename L2, typename R2>
+bool operator>(const Mystring_concat<L1, R1> &lhs, const Mystring_concat<L2, R2> &rhs) { return Mystring{lhs} > Mystring{rhs}; }
+
+// Hashing
+//
+// std::hash<Mystring> lets Mystring key the standard unordered containers. Mystring_hash and
+// Mystring_equal also accept views and C-style strings, so with C++20 a map declared as
+//     std::unordered_map<Mystring, int, Mystring_hash, Mystring_equal> counts;
+// can be probed with counts.find("Romeo") or a Mystring_view without building a Mystring.
+struct Mystring_hash {
+    using is_transparent = void;
+    std::size_t operator()(const Mystring &s) const { return s.hash(); }
+    std::size_t operator()(Mystring_view view) const { return view.hash(); }
+    std::size_t operator()(const char *s) const { return Mystring_view{s}.hash(); }
+};
+
+struct Mystring_equal {
+    using is_transparent = void;
+    bool operator()(Mystring_view lhs, Mystring_view rhs) const { return lhs == rhs; }
+};
+
+namespace std {
+    template <>
+    struct hash<Mystring> {
+        std::size_t operator()(const Mystring &s) const { return s.hash(); }
+    };
+}
+
 #endif // _MYSTRING_H_
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include "Mystring_Kernels.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Maps count chars one at a time - ASCII is handled inline, everything else goes to the locale
+static void to_lower_scalar(char *dest, const char *src, std::size_t count) {
+    for (std::size_t i=0; i<count; i++) {
+        unsigned char c = static_cast<unsigned char>(src[i]);
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        else if (c >= 0x80)
+            c = static_cast<unsigned char>(std::tolower(c));
+        dest[i] = static_cast<char>(c);
+    }
+}
+
+static void to_upper_scalar(char *dest, const char *src, std::size_t count) {
+    for (std::size_t i=0; i<count; i++) {
+        unsigned char c = static_cast<unsigned char>(src[i]);
+        if (c >= 'a' && c <= 'z')
+            c -= 'a' - 'A';
+        else if (c >= 0x80)
+            c = static_cast<unsigned char>(std::toupper(c));
+        dest[i] = static_cast<char>(c);
+    }
+}
+
+#if defined(__SSE2__)
+
+// Flips the 0x20 case bit of every byte in [first, last] within a block of 16 ASCII chars.
+// Bytes >= 0x80 compare as negative, so they never fall inside the range.
+static inline __m128i flip_case_in_range(__m128i block, char first, char last) {
+    __m128i above = _mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(first - 1)));
+    __m128i below = _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(last + 1)));
+    __m128i in_range = _mm_and_si128(above, below);
+    return _mm_xor_si128(block, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+}
+
+void to_lower_chars(char *dest, const char *src, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (_mm_movemask_epi8(block) != 0)
+            to_lower_scalar(dest + i, src + i, 16);      // non-ASCII bytes - let the locale decide
+        else
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), flip_case_in_range(block, 'A', 'Z'));
+    }
+    to_lower_scalar(dest + i, src + i, count - i);
+}
+
+void to_upper_chars(char *dest, const char *src, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (_mm_movemask_epi8(block) != 0)
+            to_upper_scalar(dest + i, src + i, 16);
+        else
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), flip_case_in_range(block, 'a', 'z'));
+    }
+    to_upper_scalar(dest + i, src + i, count - i);
+}
+
+#else
+
+void to_lower_chars(char *dest, const char *src, std::size_t count) {
+    to_lower_scalar(dest, src, count);
+}
+
+void to_upper_chars(char *dest, const char *src, std::size_t count) {
+    to_upper_scalar(dest, src, count);
+}
+
+#endif
+
+// memcmp already compares in wide blocks, and knowing both lengths up front
+// means neither side has to be scanned for its '\0'
+int compare_chars(const char *lhs, std::size_t lhs_len, const char *rhs, std::size_t rhs_len) {
+    std::size_t common = (lhs_len < rhs_len) ? lhs_len : rhs_len;
+    int result = (common > 0) ? std::memcmp(lhs, rhs, common) : 0;
+    if (result != 0)
+        return result;
+    if (lhs_len == rhs_len)
+        return 0;
+    return (lhs_len < rhs_len) ? -1 : 1;
+}
+
+bool equal_chars(const char *lhs, std::size_t lhs_len, const char *rhs, std::size_t rhs_len) {
+    if (lhs_len != rhs_len)
+        return false;
+    return lhs_len == 0 || std::memcmp(lhs, rhs, lhs_len) == 0;
+}
+
+// Hashing
+
+static constexpr std::uint64_t hash_secret[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+// Multiplies a and b into 128 bits and folds the halves together
+static inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+    std::uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+    std::uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+    std::uint64_t lo = (cross << 32) | (lo_lo & 0xffffffff);
+    std::uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return lo ^ hi;
+#endif
+}
+
+static inline std::uint64_t read64(const char *p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+static inline std::uint64_t read32(const char *p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+// 1 to 3 bytes: first, middle and last
+static inline std::uint64_t read_small(const char *p, std::size_t count) {
+    const unsigned char *b = reinterpret_cast<const unsigned char *>(p);
+    return (static_cast<std::uint64_t>(b[0]) << 16) | (static_cast<std::uint64_t>(b[count >> 1]) << 8) | b[count - 1];
+}
+
+std::size_t hash_chars(const char *str, std::size_t count) {
+    const char *p = str;
+    std::uint64_t seed = mix(hash_secret[0], hash_secret[1]);
+    std::uint64_t a {0}, b {0};
+    if (count <= 16) {
+        if (count >= 4) {
+            std::size_t step = (count >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + step);
+            b = (read32(p + count - 4) << 32) | read32(p + count - 4 - step);
+        } else if (count > 0) {
+            a = read_small(p, count);
+        }
+    } else {
+        std::size_t left = count;
+        if (left > 48) {
+            std::uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = mix(read64(p) ^ hash_secret[1], read64(p + 8) ^ seed);
+                seed1 = mix(read64(p + 16) ^ hash_secret[2], read64(p + 24) ^ seed1);
+                seed2 = mix(read64(p + 32) ^ hash_secret[3], read64(p + 40) ^ seed2);
+                p += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (left > 16) {
+            seed = mix(read64(p) ^ hash_secret[1], read64(p + 8) ^ seed);
+            p += 16;
+            left -= 16;
+        }
+        a = read64(p + left - 16);
+        b = read64(p + left - 8);
+    }
+    std::uint64_t h = mix(a ^ hash_secret[1], b ^ seed);
+    return static_cast<std::size_t>(mix(h ^ hash_secret[0] ^ count, h ^ hash_secret[1]));
+}
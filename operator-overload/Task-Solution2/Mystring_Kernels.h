@@ -0,0 +1,26 @@
+#ifndef _MYSTRING_KERNELS_H_
+#define _MYSTRING_KERNELS_H_
+#include <cstddef>
+
+// Character kernels used by Mystring's case conversion and comparison operators.
+// ASCII letters are mapped 16 bytes at a time with SSE2 where available; any block
+// holding a non-ASCII byte falls back to std::tolower/std::toupper so the current
+// C locale still decides how those bytes are mapped.
+
+// Writes count chars of src into dest in lowercase (dest may equal src)
+void to_lower_chars(char *dest, const char *src, std::size_t count);
+
+// Writes count chars of src into dest in uppercase (dest may equal src)
+void to_upper_chars(char *dest, const char *src, std::size_t count);
+
+// Three-way compare of two char ranges, ordered like strcmp (unsigned chars, shorter prefix first)
+int compare_chars(const char *lhs, std::size_t lhs_len, const char *rhs, std::size_t rhs_len);
+
+// true if both char ranges hold the same chars
+bool equal_chars(const char *lhs, std::size_t lhs_len, const char *rhs, std::size_t rhs_len);
+
+// 64-bit hash of count chars in the style of wyhash: 16 or 48 bytes are folded in per
+// step with 64x64->128 bit multiplies, so it runs at memory speed on long strings
+std::size_t hash_chars(const char *str, std::size_t count);
+
+#endif // _MYSTRING_KERNELS_H_
@@ -0,0 +1,115 @@
+#include <stdexcept>
+#include "Mystring_view.h"
+#include "Mystring_Kernels.h"
+
+// memchr finds each candidate first char, memcmp checks the rest
+std::size_t Mystring_view::find(Mystring_view needle, std::size_t pos) const {
+    if (needle.length == 0)
+        return (pos <= length) ? pos : npos;
+    if (pos >= length || needle.length > length - pos)
+        return npos;
+    const char *last = str + (length - needle.length);      // last place needle can start
+    const char *p = str + pos;
+    while (p <= last) {
+        p = static_cast<const char *>(std::memchr(p, needle.str[0], last - p + 1));
+        if (p == nullptr)
+            return npos;
+        if (std::memcmp(p + 1, needle.str + 1, needle.length - 1) == 0)
+            return p - str;
+        ++p;
+    }
+    return npos;
+}
+
+std::size_t Mystring_view::find(char c, std::size_t pos) const {
+    if (pos >= length)
+        return npos;
+    const char *p = static_cast<const char *>(std::memchr(str + pos, c, length - pos));
+    return (p == nullptr) ? npos : p - str;
+}
+
+Mystring_view Mystring_view::substr(std::size_t pos, std::size_t count) const {
+    if (pos > length)
+        throw std::out_of_range {"Mystring_view::substr"};
+    if (count > length - pos)
+        count = length - pos;
+    return Mystring_view{str + pos, count};
+}
+
+bool Mystring_view::starts_with(Mystring_view prefix) const {
+    return prefix.length <= length && equal_chars(str, prefix.length, prefix.str, prefix.length);
+}
+
+bool Mystring_view::ends_with(Mystring_view suffix) const {
+    return suffix.length <= length 
+        && equal_chars(str + (length - suffix.length), suffix.length, suffix.str, suffix.length);
+}
+
+std::size_t Mystring_view::hash() const {
+    return hash_chars(str, length);
+}
+
+Mystring_split Mystring_view::split(char delim) const {
+    return Mystring_split{*this, delim};
+}
+
+// Equality
+bool operator==(Mystring_view lhs, Mystring_view rhs) {
+    return equal_chars(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+// Not equals
+bool operator!=(Mystring_view lhs, Mystring_view rhs) {
+    return !equal_chars(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+// Less than
+bool operator<(Mystring_view lhs, Mystring_view rhs) {
+    return (compare_chars(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0);
+}
+
+// Greater than
+bool operator>(Mystring_view lhs, Mystring_view rhs) {
+    return (compare_chars(lhs.data(), lhs.size(), rhs.data(), rhs.size()) > 0);
+}
+
+// overloaded insertion operator
+std::ostream &operator<<(std::ostream &os, Mystring_view rhs) {
+    rhs.write_to(os);
+    return os;
+}
+
+// Split iteration
+
+Mystring_split::iterator::iterator(Mystring_view source, char delim, bool done) 
+    : field{}, rest{source}, delim{delim}, last{false}, done{done} {
+        if (!done)
+            next_field();
+}
+
+// Cut the next field off the front of rest
+void Mystring_split::iterator::next_field() {
+    std::size_t pos = rest.find(delim);
+    if (pos == Mystring_view::npos) {
+        field = rest;
+        rest = Mystring_view{rest.data() + rest.size(), 0};
+        last = true;
+    } else {
+        field = rest.substr(0, pos);
+        rest = rest.substr(pos + 1);
+    }
+}
+
+Mystring_split::iterator &Mystring_split::iterator::operator++() {
+    if (last)
+        done = true;
+    else
+        next_field();
+    return *this;
+}
+
+bool Mystring_split::iterator::operator==(const iterator &rhs) const {
+    if (done || rhs.done)
+        return done == rhs.done;
+    return field.data() == rhs.field.data();
+}
@@ -0,0 +1,100 @@
+#ifndef _MYSTRING_VIEW_H_
+#define _MYSTRING_VIEW_H_
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+
+class Mystring_split;
+
+// A non-owning run of chars - a pointer and a length into a Mystring, a C-style string
+// or any other char buffer. Views never allocate; the chars must outlive the view.
+class Mystring_view
+{
+private:
+    const char *str;      // first char - not necessarily followed by a '\0'
+    std::size_t length;  // number of chars in the view
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    
+    Mystring_view() 
+        : str{""}, length{0} {}
+    Mystring_view(const char *s) 
+        : str{s ? s : ""}, length{std::strlen(str)} {}
+    Mystring_view(const char *s, std::size_t length) 
+        : str{s}, length{length} {}
+    
+    const char *data() const { return str; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    char operator[](std::size_t i) const { return str[i]; }
+    
+    // Position of the first occurrence of needle (or c) at or after pos, or npos
+    std::size_t find(Mystring_view needle, std::size_t pos = 0) const;
+    std::size_t find(char c, std::size_t pos = 0) const;
+    
+    // The count chars starting at pos (fewer if the view ends first); throws std::out_of_range if pos > size()
+    Mystring_view substr(std::size_t pos, std::size_t count = npos) const;
+    
+    bool starts_with(Mystring_view prefix) const;
+    bool ends_with(Mystring_view suffix) const;
+    
+    // Same value as Mystring::hash() for the same chars
+    std::size_t hash() const;
+    
+    // The fields between each delim, e.g. for (Mystring_view field : line.split(','))
+    Mystring_split split(char delim) const;
+    
+    // Used when a view is part of a concatenation
+    char *copy_to(char *dest) const {
+        std::memcpy(dest, str, length);
+        return dest + length;
+    }
+    void write_to(std::ostream &os) const { os.write(str, length); }
+};
+
+// Comparisons take views, so any mix of Mystrings, views and C-style strings compares without copying
+bool operator==(Mystring_view lhs, Mystring_view rhs);     // equals
+bool operator!=(Mystring_view lhs, Mystring_view rhs);      // not equals
+bool operator<(Mystring_view lhs, Mystring_view rhs);       // less than
+bool operator>(Mystring_view lhs, Mystring_view rhs);       // greater than
+std::ostream &operator<<(std::ostream &os, Mystring_view rhs);
+
+// The fields of a view separated by a delimiter, visited in order without copying.
+// "a,,b" splits into "a", "" and "b"; a view with no delimiter is a single field.
+class Mystring_split
+{
+private:
+    Mystring_view source;
+    char delim;
+public:
+    class iterator {
+    private:
+        Mystring_view field;        // current field
+        Mystring_view rest;         // everything after the delimiter that ended field
+        char delim;
+        bool last;                      // field is the final one
+        bool done;                     // past the final field
+        void next_field();
+    public:
+        iterator(Mystring_view source, char delim, bool done);
+        Mystring_view operator*() const { return field; }
+        iterator &operator++();
+        bool operator==(const iterator &rhs) const;
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+    };
+    
+    Mystring_split(Mystring_view source, char delim) 
+        : source{source}, delim{delim} {}
+    iterator begin() const { return iterator{source, delim, false}; }
+    iterator end() const { return iterator{source, delim, true}; }
+};
+
+namespace std {
+    template <>
+    struct hash<Mystring_view> {
+        std::size_t operator()(Mystring_view view) const { return view.hash(); }
+    };
+}
+
+#endif // _MYSTRING_VIEW_H_